@@ -1,4 +1,5 @@
 #include "ReactorAnimations.h"
+#include "ReactorRandom.h"
 #include <Arduino.h>
 
 namespace ReactorAnimations {
@@ -49,10 +50,10 @@ void drawDecayParticles(Adafruit_SSD1306& display, uint32_t nowMs) {
   // Spawn new particle every 200ms
   if (nowMs - lastParticleSpawn > 200) {
     lastParticleSpawn = nowMs;
-    float x = SCREEN_WIDTH / 2 + random(-10, 10);
+    float x = SCREEN_WIDTH / 2 + ReactorRandom::range(-10, 10);
     float y = (CONTENT_Y_START + CONTENT_Y_END) / 2;
-    float vx = (random(-20, 20)) / 20.0f;
-    float vy = -0.5f - (random(0, 10) / 20.0f);  // Upward
+    float vx = (ReactorRandom::range(-20, 20)) / 20.0f;
+    float vy = -0.5f - (ReactorRandom::below(10) / 20.0f);  // Upward
     spawnParticle(x, y, vx, vy, 40);
   }
   
@@ -73,10 +74,10 @@ void drawCoolantFlow(Adafruit_SSD1306& display, uint32_t nowMs) {
   // Spawn droplets from top of content area
   if (nowMs - lastParticleSpawn > 150) {
     lastParticleSpawn = nowMs;
-    float x = 8 + random(0, SCREEN_WIDTH - 16);
+    float x = 8 + ReactorRandom::below(SCREEN_WIDTH - 16);
     float y = CONTENT_Y_START;
-    float vx = (random(-5, 5)) / 10.0f;
-    float vy = 0.8f + (random(0, 10) / 20.0f);  // Downward
+    float vx = (ReactorRandom::range(-5, 5)) / 10.0f;
+    float vy = 0.8f + (ReactorRandom::below(10) / 20.0f);  // Downward
     spawnParticle(x, y, vx, vy, 35);
   }
   
@@ -97,10 +98,10 @@ void drawMeltdownSparks(Adafruit_SSD1306& display, uint32_t nowMs) {
   // Frequent explosive sparks
   if (nowMs - lastParticleSpawn > 80) {
     lastParticleSpawn = nowMs;
-    float x = SCREEN_WIDTH / 2 + random(-20, 20);
+    float x = SCREEN_WIDTH / 2 + ReactorRandom::range(-20, 20);
     float y = (CONTENT_Y_START + CONTENT_Y_END) / 2;
-    float angle = random(0, 628) / 100.0f;  // 0 to 2*PI
-    float speed = 1.0f + random(0, 15) / 10.0f;
+    float angle = ReactorRandom::below(628) / 100.0f;  // 0 to 2*PI
+    float speed = 1.0f + ReactorRandom::below(15) / 10.0f;
     float vx = cos(angle) * speed;
     float vy = sin(angle) * speed;
     spawnParticle(x, y, vx, vy, 25);
@@ -127,10 +128,10 @@ void drawFreezeParticles(Adafruit_SSD1306& display, uint32_t nowMs) {
   // Gentle falling snowflakes
   if (nowMs - lastParticleSpawn > 250) {
     lastParticleSpawn = nowMs;
-    float x = 8 + random(0, SCREEN_WIDTH - 16);
+    float x = 8 + ReactorRandom::below(SCREEN_WIDTH - 16);
     float y = CONTENT_Y_START;
-    float vx = (random(-8, 8)) / 20.0f;
-    float vy = 0.3f + (random(0, 10) / 30.0f);  // Slow fall
+    float vx = (ReactorRandom::range(-8, 8)) / 20.0f;
+    float vy = 0.3f + (ReactorRandom::below(10) / 30.0f);  // Slow fall
     spawnParticle(x, y, vx, vy, 60);
   }
   
@@ -269,9 +270,9 @@ void drawGeigerFlashes(Adafruit_SSD1306& display, uint32_t nowMs, uint8_t intens
   uint8_t flashChance = intensity / 4;  // 0-25 range
   
   for (uint8_t i = 0; i < flashChance; i++) {
-    if (random(100) < intensity) {
-      int16_t x = 8 + random(SCREEN_WIDTH - 16);
-      int16_t y = CONTENT_Y_START + random(CONTENT_HEIGHT);
+    if (ReactorRandom::below(100) < intensity) {
+      int16_t x = 8 + ReactorRandom::below(SCREEN_WIDTH - 16);
+      int16_t y = CONTENT_Y_START + ReactorRandom::below(CONTENT_HEIGHT);
       display.drawPixel(x, y, SSD1306_WHITE);
     }
   }
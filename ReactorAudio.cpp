@@ -1,4 +1,5 @@
 #include "ReactorAudio.h"
+#include "ReactorTrace.h"
 
 namespace ReactorAudio {
 
@@ -20,6 +21,10 @@ bool isMuted() {
   return g_muteUntil && (millis() < g_muteUntil);
 }
 
+bool isSounding() {
+  return g_toneOn;
+}
+
 void off() {
   if (g_toneOn) {
     noTone(g_buzzerPin);
@@ -39,15 +44,22 @@ void toneHz(unsigned int hz) {
 
 void muteFor(unsigned long ms) {
   g_muteUntil = millis() + ms;
+  unsigned long secs = ms / 1000;
+  ReactorTrace::record(ReactorTrace::TR_MUTE, secs > 255 ? 255 : (uint8_t)secs);
   off();
 }
 
+void unmute() {
+  g_muteUntil = 0;
+}
+
 void tickMute() {
   if (!g_muteUntil) return;
   if (millis() < g_muteUntil) {
     off();
   } else {
     g_muteUntil = 0;
+    ReactorTrace::record(ReactorTrace::TR_MUTE, 0);
   }
 }
 
@@ -8,7 +8,9 @@ void begin(uint8_t buzzerPin);
 void toneHz(unsigned int hz);
 void off();
 void muteFor(unsigned long ms);
+void unmute();
 bool isMuted();
+bool isSounding();
 void tickMute();
 void playFinalCountdown();
 
@@ -0,0 +1,134 @@
+#include "ReactorBench.h"
+
+#ifdef REACTOR_BENCH
+
+#include "ReactorAnimations.h"
+#include "ReactorUI.h"
+#include "ReactorChaos.h"
+#include "ReactorRandom.h"
+
+namespace ReactorBench {
+
+namespace {
+  const uint16_t BENCH_SEED     = 0x5EED;
+  const uint16_t BENCH_FRAME_MS = 33;   // virtual clock step handed to the primitives
+
+  typedef void (*CaseFn)(uint32_t nowMs, uint16_t frame);
+
+  struct Case {
+    const char* name;    // PROGMEM
+    CaseFn      fn;
+    uint16_t    frames;
+  };
+
+  inline Adafruit_SSD1306& gfx() { return ReactorUI::display; }
+
+  void benchChaoticWave(uint32_t now, uint16_t)      { ReactorAnimations::drawChaoticWave(gfx(), now); }
+  void benchMeltdownSparks(uint32_t now, uint16_t)   { ReactorAnimations::drawMeltdownSparks(gfx(), now); }
+  void benchGeigerFlashes(uint32_t now, uint16_t)    { ReactorAnimations::drawGeigerFlashes(gfx(), now, 90); }
+  void benchRadarSweep(uint32_t now, uint16_t f)     { ReactorAnimations::drawRadarSweep(gfx(), now, f % 101); }
+  void benchTransitionFade(uint32_t, uint16_t f)     { ReactorAnimations::transitionFade(gfx(), f % 101); }
+  void benchChaosGlitches(uint32_t, uint16_t)        { ReactorChaos::drawGlitches(); }
+
+  // Full renderer passes include the heat bar and the panel flush
+  void renderMode(Mode mode, uint16_t f) {
+    ReactorUI::UIMetrics m;
+    m.heatPercent = 40 + (f % 60);
+    m.countdownMs = (mode == MODE_MELTDOWN) ? 10000 - (int32_t)(f % 100) * 100 : -1;
+    m.progress    = f % 101;
+    ReactorUI::ui.render(mode, m, false);
+  }
+  void benchHeatBar(uint32_t, uint16_t f) {
+    ReactorUI::UIMetrics m;
+    m.heatPercent = f % 101;
+    ReactorUI::uiHeatBar(m);
+  }
+  void benchRenderStable(uint32_t, uint16_t f)   { renderMode(MODE_STABLE, f); }
+  void benchRenderMeltdown(uint32_t, uint16_t f) { renderMode(MODE_MELTDOWN, f); }
+
+  // Generator cost: the Arduino core's random() against ReactorRandom for
+  // the same bounded draws (the old and new Geiger / chaos call pattern)
+  const uint8_t RNG_DRAWS = 64;
+  volatile uint16_t rngSink;
+  void benchRngArduino(uint32_t, uint16_t) {
+    for (uint8_t i = 0; i < RNG_DRAWS; ++i) rngSink = random(100);
+  }
+  void benchRngBelow(uint32_t, uint16_t) {
+    for (uint8_t i = 0; i < RNG_DRAWS; ++i) rngSink = ReactorRandom::below(100);
+  }
+  void benchRngFill(uint32_t, uint16_t) {
+    uint8_t buf[RNG_DRAWS];
+    ReactorRandom::fillBytes(buf, sizeof(buf));
+    rngSink = buf[0];
+  }
+
+  const char N_WAVE[]     PROGMEM = "drawChaoticWave";
+  const char N_SPARKS[]   PROGMEM = "drawMeltdownSparks";
+  const char N_GEIGER[]   PROGMEM = "drawGeigerFlashes";
+  const char N_RADAR[]    PROGMEM = "drawRadarSweep";
+  const char N_FADE[]     PROGMEM = "transitionFade";
+  const char N_CHAOS[]    PROGMEM = "chaosGlitches";
+  const char N_HEATBAR[]  PROGMEM = "uiHeatBar";
+  const char N_STABLE[]   PROGMEM = "render_STABLE";
+  const char N_MELTDOWN[] PROGMEM = "render_MELTDOWN";
+  const char N_RNG_ARD[]  PROGMEM = "rng_random64";
+  const char N_RNG_BEL[]  PROGMEM = "rng_below64";
+  const char N_RNG_FILL[] PROGMEM = "rng_fillBytes64";
+
+  const Case CASES[] PROGMEM = {
+    { N_WAVE,     benchChaoticWave,    1000 },
+    { N_SPARKS,   benchMeltdownSparks, 1000 },
+    { N_GEIGER,   benchGeigerFlashes,  1000 },
+    { N_RADAR,    benchRadarSweep,     1000 },
+    { N_FADE,     benchTransitionFade, 1000 },
+    { N_CHAOS,    benchChaosGlitches,  1000 },
+    { N_HEATBAR,  benchHeatBar,        1000 },
+    { N_STABLE,   benchRenderStable,    100 },
+    { N_MELTDOWN, benchRenderMeltdown,  100 },
+    { N_RNG_ARD,  benchRngArduino,      100 },
+    { N_RNG_BEL,  benchRngBelow,        100 },
+    { N_RNG_FILL, benchRngFill,         100 },
+  };
+  const uint8_t CASE_COUNT = sizeof(CASES) / sizeof(CASES[0]);
+}
+
+void run(Print& out) {
+  // Every case reseeds; the session's own sequence resumes afterwards
+  uint32_t rng = ReactorRandom::save();
+  out.println(F("case,frames,us_total,ns_per_frame,lit_avg"));
+  for (uint8_t i = 0; i < CASE_COUNT; ++i) {
+    CaseFn   fn     = (CaseFn)pgm_read_ptr(&CASES[i].fn);
+    uint16_t frames = pgm_read_word(&CASES[i].frames);
+
+    randomSeed(BENCH_SEED);
+    ReactorRandom::seed(BENCH_SEED);
+    ReactorAnimations::resetParticles();
+
+    // Only the draw call is timed; clearing and pixel counting are not
+    uint32_t usTotal = 0, litTotal = 0;
+    for (uint16_t f = 0; f < frames; ++f) {
+      gfx().clearDisplay();
+      unsigned long t0 = micros();
+      fn((uint32_t)f * BENCH_FRAME_MS, f);
+      usTotal += micros() - t0;
+      litTotal += ReactorUI::litPixels();
+    }
+
+    out.print((const __FlashStringHelper*)pgm_read_ptr(&CASES[i].name));
+    out.print(',');
+    out.print(frames);
+    out.print(',');
+    out.print(usTotal);
+    out.print(',');
+    out.print((unsigned long)((uint64_t)usTotal * 1000 / frames));
+    out.print(',');
+    out.println(litTotal / frames);
+  }
+  ReactorAnimations::resetParticles();
+  gfx().clearDisplay();
+  ReactorRandom::restore(rng);
+}
+
+} // namespace ReactorBench
+
+#endif // REACTOR_BENCH
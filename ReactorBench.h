@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorBench {
+
+// Run every renderer primitive, plus the RNG cost cases, over a fixed number
+// of frames (fixed RNG seed, virtual frame clock) and print one CSV row per case:
+//   case,frames,us_total,ns_per_frame,lit_avg
+// lit_avg (lit pixels per frame) stands in for GFX call counts, which the
+// library gives no hook for on the board. The session's ReactorRandom state
+// is restored afterwards, so a bench run doesn't perturb a replay.
+// Only compiled in with -DREACTOR_BENCH; exposed as the console 'bench' command.
+void run(Print& out);
+
+} // namespace ReactorBench
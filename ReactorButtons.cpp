@@ -1,4 +1,5 @@
 #include "ReactorButtons.h"
+#include "ReactorReplay.h"
 
 namespace ReactorButtons {
 
@@ -22,18 +23,20 @@ Button shutdownBtn;
 Button eventBtn;
 Button ackBtn;
 
-void Button::begin(uint8_t p) {
+void Button::begin(uint8_t p, char c) {
   pin = p;
+  code = c;
   pinMode(pin, INPUT_PULLUP);
   bool r = digitalRead(pin);
   stableState = r;
   lastRaw = r;
   changedAt = 0;
   fellEvent = roseEvent = false;
+  forced = false;
 }
 
 void Button::update() {
-  bool raw = digitalRead(pin);
+  bool raw = forced ? LOW : digitalRead(pin);
   unsigned long now = millis();
   if (raw != lastRaw) {
     lastRaw = raw;
@@ -42,7 +45,13 @@ void Button::update() {
   if (now - changedAt > DEBOUNCE_MS) {
     if (raw != stableState) {
       stableState = raw;
-      if (stableState == LOW) fellEvent = true; else roseEvent = true;
+      if (stableState == LOW) {
+        fellEvent = true;
+        ReactorReplay::recordEdge(code);
+      } else {
+        roseEvent = true;
+        ReactorReplay::recordEdge(code | 0x20);
+      }
     }
   }
 }
@@ -52,13 +61,13 @@ bool Button::rose() { bool e = roseEvent; roseEvent = false; return e; }
 bool Button::isPressed() const { return stableState == LOW; }
 
 void begin() {
-  overrideBtn.begin(PIN_BUTTON_OVERRIDE);
-  stabilizeBtn.begin(PIN_BUTTON_STABILIZE);
-  startupBtn.begin(PIN_BUTTON_STARTUP);
-  freezedownBtn.begin(PIN_BUTTON_FREEZEDOWN);
-  shutdownBtn.begin(PIN_BUTTON_SHUTDOWN);
-  eventBtn.begin(PIN_BUTTON_EVENT);
-  ackBtn.begin(PIN_BUTTON_ACK);
+  overrideBtn.begin(PIN_BUTTON_OVERRIDE, 'O');
+  stabilizeBtn.begin(PIN_BUTTON_STABILIZE, 'S');
+  startupBtn.begin(PIN_BUTTON_STARTUP, 'U');
+  freezedownBtn.begin(PIN_BUTTON_FREEZEDOWN, 'F');
+  shutdownBtn.begin(PIN_BUTTON_SHUTDOWN, 'D');
+  eventBtn.begin(PIN_BUTTON_EVENT, 'E');
+  ackBtn.begin(PIN_BUTTON_ACK, 'A');
 }
 
 void update() {
@@ -71,4 +80,64 @@ void update() {
   ackBtn.update();
 }
 
+namespace {
+  Button* find(char code) {
+    Button* all[] = { &overrideBtn, &stabilizeBtn, &startupBtn, &freezedownBtn,
+                      &shutdownBtn, &eventBtn, &ackBtn };
+    for (uint8_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) {
+      if (all[i]->code == code) return all[i];
+    }
+    return 0;
+  }
+}
+
+bool inject(char code) {
+  Button* b = find(code);
+  if (!b) return false;
+  b->fellEvent = true;
+  ReactorReplay::recordEdge(code);
+  ReactorReplay::recordEdge(code | 0x20);
+  return true;
+}
+
+bool hold(char code, bool down) {
+  Button* b = find(code);
+  if (!b) return false;
+  b->forced = down;
+  b->stableState = b->lastRaw = down ? LOW : HIGH;
+  b->changedAt = millis();
+  if (down) b->fellEvent = true;
+  else      b->roseEvent = true;
+  ReactorReplay::recordEdge(down ? code : (char)(code | 0x20));
+  return true;
+}
+
+// Release edges aren't checked: nothing reads rose(), so one would stay
+// pending for good after the first press and keep MODE_DARK awake
+bool idle() {
+  const Button* all[] = { &overrideBtn, &stabilizeBtn, &startupBtn, &freezedownBtn,
+                          &shutdownBtn, &eventBtn, &ackBtn };
+  for (uint8_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) {
+    const Button* b = all[i];
+    if (b->stableState == LOW || b->lastRaw != b->stableState || b->fellEvent) return false;
+  }
+  return true;
+}
+
+// Startup is D10 = PB4 = PCINT4 on the Mega 2560
+void wakeOnStartup(bool on) {
+  if (on) {
+    PCIFR = _BV(PCIF0);   // drop a stale edge
+    PCMSK0 |= _BV(PCINT4);
+    PCICR |= _BV(PCIE0);
+  } else {
+    PCICR &= ~_BV(PCIE0);
+    PCMSK0 &= ~_BV(PCINT4);
+  }
+}
+
+// Only here to end power-down; the debouncer picks the press up as usual
+ISR(PCINT0_vect) {
+}
+
 } // namespace ReactorButtons
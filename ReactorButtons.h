@@ -6,13 +6,15 @@ namespace ReactorButtons {
 
 struct Button {
   uint8_t pin;
+  char code;              // 'O','S','U','F','D','E','A' (secrets, trace, replay)
   bool stableState;
   bool lastRaw;
   unsigned long changedAt;
   bool fellEvent;
   bool roseEvent;
+  bool forced;            // held down by hold() (replay); the pin is ignored
 
-  void begin(uint8_t p);
+  void begin(uint8_t p, char c);
   void update();
   bool fell();
   bool rose();
@@ -30,4 +32,19 @@ extern Button ackBtn;
 void begin();
 void update();
 
+// Raise a press edge as if it had been debounced (console, fuzz); recorded
+// as a press and an immediate release
+bool inject(char code);
+
+// Press (down) or release a button as if debounced and keep it in that state
+// until released, whatever its pin reads, so isPressed() chords replay too
+bool hold(char code, bool down);
+
+// No button held, settling, or with an unread edge (safe to power down)
+bool idle();
+
+// Arm or disarm the pin-change interrupt on Startup, the only wake source
+// from power-down in MODE_DARK. Arm with interrupts disabled.
+void wakeOnStartup(bool on);
+
 } // namespace ReactorButtons
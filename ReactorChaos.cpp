@@ -2,83 +2,162 @@
 #include "ReactorAudio.h"
 #include "ReactorHeat.h"
 #include "ReactorUI.h"
+#include "ReactorLeds.h"
+#include "ReactorRandom.h"
 
 namespace ReactorChaos {
 
 // ======================= State Variables =======================
 unsigned long chaosTickAt = 0;
+unsigned long chaosFrameAt = 0;
 unsigned long chaosInvertAt = 0;
 
-// ======================= Pins =======================
-const uint8_t PIN_LED_MELTDOWN      = 13;
-const uint8_t PIN_LED_STABLE        = 12;
-const uint8_t PIN_LED_STARTUP       = 11;
-const uint8_t PIN_LED_FREEZEDOWN    = 9;
+// ======================= Tunables =======================
+const unsigned long CHAOS_TICK_MS   = 60;   // LEDs, heat bar, buzzer
+const unsigned long CHAOS_FRAME_MS  = 30;   // framebuffer glitches
+const unsigned long CHAOS_INVERT_MS = 180;
+
+const uint8_t CHAOS_W     = 128;            // framebuffer geometry (SSD1306 128x64)
+const uint8_t CHAOS_PAGES = 8;
+
+// Stripe fills, as page bytes (bit 0 = top row of the page)
+const uint8_t STRIPES[] PROGMEM = { 0xFF, 0xAA, 0x0F, 0x81, 0x3C, 0x55 };
 
 // ======================= Helpers =======================
 inline void buzzerTone(unsigned int hz) { ReactorAudio::toneHz(hz); }
+inline void ledSet(ReactorLeds::Led led, bool on) { ReactorLeds::set(ReactorLeds::OWNER_MODE, led, on); }
+
+inline uint8_t* pageRow(uint8_t page) {
+  return ReactorUI::display.getBuffer() + (uint16_t)page * CHAOS_W;
+}
+
+static void reverse(uint8_t* a, uint8_t* b) {
+  while (a < --b) { uint8_t t = *a; *a++ = *b; *b = t; }
+}
+
+// ======================= Glitches =======================
+// Each one edits whole bytes of one page (8 rows x n columns) and returns
+// that page's bit, so the frame only pushes what changed.
+
+// Burst of random bytes
+static uint8_t glitchNoise(uint8_t page) {
+  uint8_t x = ReactorRandom::below(CHAOS_W);
+  uint8_t len = ReactorRandom::range(8, 64);
+  if (len > CHAOS_W - x) len = CHAOS_W - x;
+  ReactorRandom::fillBytes(pageRow(page) + x, len);
+  return 1 << page;
+}
+
+// Sparse sparkle: XOR two random words so about one pixel in four flips
+static uint8_t glitchSparkle(uint8_t page) {
+  uint8_t* row = pageRow(page);
+  for (uint8_t x = 0; x < CHAOS_W; x += 4) {
+    uint32_t bits = ReactorRandom::next() & ReactorRandom::next();
+    row[x]     ^= (uint8_t)bits;
+    row[x + 1] ^= (uint8_t)(bits >> 8);
+    row[x + 2] ^= (uint8_t)(bits >> 16);
+    row[x + 3] ^= (uint8_t)(bits >> 24);
+  }
+  return 1 << page;
+}
+
+// Solid/patterned band
+static uint8_t glitchStripe(uint8_t page) {
+  uint8_t x = ReactorRandom::below(CHAOS_W);
+  uint8_t len = ReactorRandom::range(16, CHAOS_W);
+  if (len > CHAOS_W - x) len = CHAOS_W - x;
+  memset(pageRow(page) + x, pgm_read_byte(&STRIPES[ReactorRandom::below(sizeof(STRIPES))]), len);
+  return 1 << page;
+}
+
+// Horizontal tear: rotate the page by k columns (three in-place reversals)
+static uint8_t glitchTear(uint8_t page) {
+  uint8_t* row = pageRow(page);
+  uint8_t k = ReactorRandom::range(1, CHAOS_W);
+  reverse(row, row + k);
+  reverse(row + k, row + CHAOS_W);
+  reverse(row, row + CHAOS_W);
+  return 1 << page;
+}
+
+// Vertical slip: another page's content copied over this one
+static uint8_t glitchShift(uint8_t page) {
+  uint8_t src = ReactorRandom::below(CHAOS_PAGES);
+  if (src == page) return 0;
+  memcpy(pageRow(page), pageRow(src), CHAOS_W);
+  return 1 << page;
+}
+
+static uint8_t glitchBlank(uint8_t page) {
+  memset(pageRow(page), 0, CHAOS_W);
+  return 1 << page;
+}
 
 // ======================= API =======================
 void begin() {
-  pinMode(PIN_LED_MELTDOWN, OUTPUT);
-  pinMode(PIN_LED_STABLE, OUTPUT);
-  pinMode(PIN_LED_STARTUP, OUTPUT);
-  pinMode(PIN_LED_FREEZEDOWN, OUTPUT);
   reset();
 }
 
 void reset() {
   chaosTickAt = 0;
+  chaosFrameAt = 0;
   chaosInvertAt = 0;
   
   // Kill everything
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   ReactorUI::display.clearDisplay();
-  ReactorUI::display.display();
+  ReactorUI::flush();
+}
+
+uint8_t drawGlitches() {
+  uint8_t dirty = 0;
+  uint8_t ops = ReactorRandom::range(2, 5);
+  while (ops--) {
+    uint8_t page = ReactorRandom::below(CHAOS_PAGES);
+    switch (ReactorRandom::below(8)) {
+      case 0:
+      case 1:  dirty |= glitchNoise(page); break;
+      case 2:  dirty |= glitchSparkle(page); break;
+      case 3:  dirty |= glitchStripe(page); break;
+      case 4:
+      case 5:  dirty |= glitchTear(page); break;
+      case 6:  dirty |= glitchShift(page); break;
+      default: dirty |= glitchBlank(page); break;
+    }
+  }
+  return dirty;
 }
 
 void tick() {
   unsigned long now = millis();
 
   // Randomize indicator LEDs fast
-  if (now - chaosTickAt >= 60) {
+  if (now - chaosTickAt >= CHAOS_TICK_MS) {
     chaosTickAt = now;
-    digitalWrite(PIN_LED_MELTDOWN,  random(2) ? HIGH : LOW);
-    digitalWrite(PIN_LED_STABLE,    random(2) ? HIGH : LOW);
-    digitalWrite(PIN_LED_STARTUP,   random(2) ? HIGH : LOW);
-    digitalWrite(PIN_LED_FREEZEDOWN,random(2) ? HIGH : LOW);
+    ledSet(ReactorLeds::LED_MELTDOWN,   ReactorRandom::coin());
+    ledSet(ReactorLeds::LED_STABLE,     ReactorRandom::coin());
+    ledSet(ReactorLeds::LED_STARTUP,    ReactorRandom::coin());
+    ledSet(ReactorLeds::LED_FREEZEDOWN, ReactorRandom::coin());
 
     // Heat bar raw flicker (override smoothing while in CHAOS)
     ReactorHeat::chaosFlicker();
 
     // Buzzer chaos (still respects mute via wrapper)
-    int f = random(220, 2200);
+    int f = ReactorRandom::range(220, 2200);
     buzzerTone(f);
+  }
 
-    // LCD artifacts
-    int w = ReactorUI::display.width();
-    int h = ReactorUI::display.height();
-    if (random(4) == 0) {
-      ReactorUI::display.fillRect(random(w), random(h), random(10, 40), random(4, 20), SSD1306_WHITE);
-    } else if (random(4) == 0) {
-      ReactorUI::display.drawLine(random(w), random(h),
-                                  random(w), random(h),
-                                  SSD1306_WHITE);
-    } else {
-      for (int i = 0; i < 60; ++i)
-        ReactorUI::display.drawPixel(random(w), random(h), SSD1306_WHITE);
-    }
-    if (random(5) == 0) ReactorUI::display.clearDisplay();
-    ReactorUI::display.display();
+  // LCD artifacts straight into the framebuffer; only touched pages go out
+  if (now - chaosFrameAt >= CHAOS_FRAME_MS) {
+    chaosFrameAt = now;
+    uint8_t dirty = drawGlitches();
+    if (dirty) ReactorUI::flushPages(dirty);
   }
 
   // Periodic invert flash
-  if (now - chaosInvertAt >= 180) {
+  if (now - chaosInvertAt >= CHAOS_INVERT_MS) {
     chaosInvertAt = now;
-    ReactorUI::display.invertDisplay(random(2));
+    ReactorUI::display.invertDisplay(ReactorRandom::coin());
   }
 }
 
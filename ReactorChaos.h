@@ -13,4 +13,8 @@ void tick();
 // Reset state when entering chaos
 void reset();
 
+// One frame of glitches written straight into the framebuffer; returns the
+// mask of pages touched (bit n = rows 8n..8n+7)
+uint8_t drawGlitches();
+
 } // namespace ReactorChaos
@@ -0,0 +1,338 @@
+#include "ReactorConsole.h"
+#include "ReactorTrace.h"
+#include "ReactorStateMachine.h"
+#include "ReactorReplay.h"
+#include "ReactorDiag.h"
+#include "ReactorUI.h"
+#include "ReactorBench.h"
+#include "ReactorFuzz.h"
+#include "ReactorStats.h"
+#include "ReactorTunables.h"
+#include "ReactorButtons.h"
+#include "ReactorEvents.h"
+#include "ReactorSecrets.h"
+#include "ReactorMirror.h"
+
+namespace ReactorConsole {
+
+namespace {
+  const uint8_t LINE_MAX = 32;
+  char    line[LINE_MAX];
+  uint8_t lineLen = 0;
+  bool    overflow = false;
+
+  // Queued button presses ("press"), fed to ReactorButtons one at a time
+  const uint8_t PRESS_MAX = 16;
+  char          presses[PRESS_MAX];
+  uint8_t       pressHead = 0;
+  uint8_t       pressLen = 0;
+  uint16_t      pressGapMs = 0;
+  unsigned long pressAt = 0;
+
+  typedef void (*Handler)(char* args);
+
+  struct Command {
+    const char* name;  // PROGMEM
+    Handler     fn;
+    const char* help;  // PROGMEM
+  };
+
+  void cmdHelp(char* args);
+
+  void cmdTrace(char* args) {
+    if (strcmp_P(args, PSTR("eeprom")) == 0) ReactorTrace::dumpEeprom(Serial);
+    else                                     ReactorTrace::dump(Serial);
+  }
+
+  void cmdGraph(char*) {
+    ReactorStateMachine::dumpTransitionGraph(Serial);
+  }
+
+  void cmdSession(char*) {
+    ReactorReplay::dumpSession(Serial);
+  }
+
+  void cmdReplay(char*) {
+    ReactorReplay::startPlayback();
+  }
+
+  void cmdLoops(char* args) {
+    if (strcmp_P(args, PSTR("reset")) == 0) ReactorDiag::resetLoopRates();
+    else                                    ReactorDiag::printLoopRates(Serial);
+  }
+
+  void cmdHist(char* args) {
+    if (strcmp_P(args, PSTR("reset")) == 0) ReactorDiag::resetHistogram();
+    else                                    ReactorDiag::printHistogram(Serial);
+  }
+
+  void cmdMem(char*) {
+    ReactorDiag::printMemory(Serial);
+  }
+
+  void cmdCycles(char* args) {
+    if (strcmp_P(args, PSTR("reset")) == 0) ReactorDiag::resetCycles();
+    else                                    ReactorDiag::printCycles(Serial);
+  }
+
+  void cmdCheck(char* args) {
+    if (strcmp_P(args, PSTR("reset")) == 0) ReactorFuzz::resetChecks();
+    else                                    ReactorFuzz::printChecks(Serial);
+  }
+
+  void cmdStats(char* args) {
+    if      (strcmp_P(args, PSTR("reset")) == 0) ReactorStats::reset();
+    else if (strcmp_P(args, PSTR("save")) == 0)  ReactorStats::save();
+    else                                         ReactorStats::print(Serial);
+  }
+
+  // tune                  list all
+  // tune <name>           show one
+  // tune <name> <value>   set and persist
+  // tune <name> default   drop the override
+  void cmdTune(char* args) {
+    char* value = strchr(args, ' ');
+    if (value) *value++ = '\0';
+    ReactorTunables::Id id;
+    if (*args && !ReactorTunables::find(args, id)) {
+      Serial.println(F("? tunable"));
+      return;
+    }
+    if (!*args) {
+      ReactorTunables::print(Serial);
+    } else if (!value) {
+      ReactorTunables::print(Serial, id);
+    } else if (strcmp_P(value, PSTR("default")) == 0) {
+      ReactorTunables::restore(id);
+    } else {
+      unsigned long v = strtoul(value, 0, 10);
+      if (v > 0xFFFF || !ReactorTunables::set(id, (uint16_t)v)) Serial.println(F("? range"));
+    }
+  }
+
+  // press <codes> [gap_ms]   e.g. "press SOE 200"; codes as in the trace
+  void cmdPress(char* args) {
+    char* gap = strchr(args, ' ');
+    if (gap) *gap++ = '\0';
+    uint8_t n = strlen(args);
+    if (!n || n > PRESS_MAX) {
+      Serial.println(F("? codes"));
+      return;
+    }
+    memcpy(presses, args, n);
+    pressHead = 0;
+    pressLen = n;
+    pressGapMs = gap ? (uint16_t)strtoul(gap, 0, 10) : 0;
+    pressAt = millis() - pressGapMs;
+  }
+
+  void cmdMode(char* args) {
+    for (uint8_t m = 0; m < MODE_COUNT; ++m) {
+      if (strcasecmp_P(args, (const char*)ReactorStateMachine::modeName(m)) == 0) {
+        ReactorStateMachine::force((Mode)m);
+        return;
+      }
+    }
+    Serial.println(F("? mode"));
+  }
+
+  void cmdEvent(char* args) {
+    bool ok = *args ? ReactorEvents::trigger(args) : ReactorEvents::trigger();
+    if (!ok) Serial.println(F("? event"));
+  }
+
+  void cmdGod(char* args) {
+    if      (strcmp_P(args, PSTR("on")) == 0)  ReactorSecrets::setGodMode(true);
+    else if (strcmp_P(args, PSTR("off")) == 0) ReactorSecrets::setGodMode(false);
+    Serial.println(ReactorSecrets::isGodMode() ? F("god on") : F("god off"));
+  }
+
+#ifdef REACTOR_FUZZ
+  void cmdFuzz(char* args) {
+    ReactorFuzz::start(*args ? strtoul(args, 0, 10) : 10000UL);
+  }
+#endif
+
+  void cmdTrend(char*) {
+    ReactorUI::toggleTrend();
+  }
+
+  void cmdFrame(char*) {
+    ReactorUI::dumpFramePBM(Serial);
+  }
+
+  void cmdSleep(char* args) {
+    if (strcmp_P(args, PSTR("reset")) == 0) ReactorDiag::resetSleep();
+    else                                    ReactorDiag::printSleep(Serial);
+  }
+
+#ifdef REACTOR_MIRROR
+  void cmdMirror(char*) {
+    ReactorMirror::resync();
+  }
+#endif
+
+#ifdef REACTOR_BENCH
+  void cmdBench(char*) {
+    ReactorBench::run(Serial);
+  }
+#endif
+
+  const char N_HELP[]  PROGMEM = "help";
+  const char H_HELP[]  PROGMEM = "list commands";
+  const char N_TRACE[] PROGMEM = "trace";
+  const char H_TRACE[] PROGMEM = "[eeprom] dump trace ring or EEPROM snapshot";
+  const char N_GRAPH[] PROGMEM = "graph";
+  const char H_GRAPH[] PROGMEM = "print transition table as Graphviz";
+
+  const char N_SESSION[] PROGMEM = "session";
+  const char H_SESSION[] PROGMEM = "print recorded button session (seed + edges)";
+  const char N_REPLAY[]  PROGMEM = "replay";
+  const char H_REPLAY[]  PROGMEM = "restart and play the compiled-in session";
+
+  const char N_LOOPS[]   PROGMEM = "loops";
+  const char H_LOOPS[]   PROGMEM = "[reset] loop iterations per second per mode";
+
+  const char N_HIST[]    PROGMEM = "hist";
+  const char H_HIST[]    PROGMEM = "[reset] loop period histogram (log2 us) and worst loop";
+  const char N_MEM[]     PROGMEM = "mem";
+  const char H_MEM[]     PROGMEM = "SRAM: static, heap, stack peak, free now/min";
+  const char N_CYCLES[]  PROGMEM = "cycles";
+  const char H_CYCLES[]  PROGMEM = "[reset] tick/frame/flush CPU cycles per mode";
+  const char N_CHECK[]   PROGMEM = "check";
+  const char H_CHECK[]   PROGMEM = "[reset] invariant failure counts";
+  const char N_STATS[]   PROGMEM = "stats";
+  const char H_STATS[]   PROGMEM = "[reset|save] lifetime counters, dwell and uptime";
+  const char N_TUNE[]    PROGMEM = "tune";
+  const char H_TUNE[]    PROGMEM = "[name [value|default]] list, show or set a tunable (saved)";
+  const char N_PRESS[]   PROGMEM = "press";
+  const char H_PRESS[]   PROGMEM = "<OSUFDEA...> [gap_ms] queue button presses";
+  const char N_MODE[]    PROGMEM = "mode";
+  const char H_MODE[]    PROGMEM = "<name> force a mode, skipping the transition table";
+  const char N_EVENT[]   PROGMEM = "event";
+  const char H_EVENT[]   PROGMEM = "[leak|spike|sensor|jam] open an incident";
+  const char N_GOD[]     PROGMEM = "god";
+  const char H_GOD[]     PROGMEM = "[on|off] show or set god mode";
+#ifdef REACTOR_FUZZ
+  const char N_FUZZ[]    PROGMEM = "fuzz";
+  const char H_FUZZ[]    PROGMEM = "[n] inject n random button edges (0 stops)";
+#endif
+  const char N_TREND[]   PROGMEM = "trend";
+  const char H_TREND[]   PROGMEM = "toggle the STABLE heat trend graph";
+  const char N_FRAME[]   PROGMEM = "frame";
+  const char H_FRAME[]   PROGMEM = "dump current framebuffer as PBM (P1)";
+  const char N_SLEEP[]   PROGMEM = "sleep";
+  const char H_SLEEP[]   PROGMEM = "[reset] DARK power-down count and wake-to-frame latency";
+#ifdef REACTOR_MIRROR
+  const char N_MIRROR[]  PROGMEM = "mirror";
+  const char H_MIRROR[]  PROGMEM = "resend the whole frame to the mirror (mirror_ms)";
+#endif
+#ifdef REACTOR_BENCH
+  const char N_BENCH[]   PROGMEM = "bench";
+  const char H_BENCH[]   PROGMEM = "renderer microbenchmarks (CSV)";
+#endif
+
+  const Command COMMANDS[] PROGMEM = {
+    { N_HELP,  cmdHelp,  H_HELP  },
+    { N_TRACE, cmdTrace, H_TRACE },
+    { N_GRAPH, cmdGraph, H_GRAPH },
+    { N_SESSION, cmdSession, H_SESSION },
+    { N_REPLAY,  cmdReplay,  H_REPLAY  },
+    { N_LOOPS,   cmdLoops,   H_LOOPS   },
+    { N_HIST,    cmdHist,    H_HIST    },
+    { N_MEM,     cmdMem,     H_MEM     },
+    { N_CYCLES,  cmdCycles,  H_CYCLES  },
+    { N_CHECK,   cmdCheck,   H_CHECK   },
+    { N_SLEEP,   cmdSleep,   H_SLEEP   },
+    { N_STATS,   cmdStats,   H_STATS   },
+    { N_TUNE,    cmdTune,    H_TUNE    },
+    { N_PRESS,   cmdPress,   H_PRESS   },
+    { N_MODE,    cmdMode,    H_MODE    },
+    { N_EVENT,   cmdEvent,   H_EVENT   },
+    { N_GOD,     cmdGod,     H_GOD     },
+#ifdef REACTOR_FUZZ
+    { N_FUZZ,    cmdFuzz,    H_FUZZ    },
+#endif
+    { N_TREND,   cmdTrend,   H_TREND   },
+    { N_FRAME,   cmdFrame,   H_FRAME   },
+#ifdef REACTOR_MIRROR
+    { N_MIRROR,  cmdMirror,  H_MIRROR  },
+#endif
+#ifdef REACTOR_BENCH
+    { N_BENCH,   cmdBench,   H_BENCH   },
+#endif
+  };
+  const uint8_t COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+  void cmdHelp(char*) {
+    for (uint8_t i = 0; i < COMMAND_COUNT; ++i) {
+      Serial.print((const __FlashStringHelper*)pgm_read_ptr(&COMMANDS[i].name));
+      Serial.print(F(" - "));
+      Serial.println((const __FlashStringHelper*)pgm_read_ptr(&COMMANDS[i].help));
+    }
+    Serial.println(F("# DARK powers down: Serial input (commands, replay) is lost until"));
+    Serial.println(F("# STARTUP, unless telemetry_ms or mirror_ms is set"));
+  }
+
+  void execute(char* text) {
+    // Split "name args..." in place
+    while (*text == ' ') ++text;
+    if (!*text) return;
+    char* args = text;
+    while (*args && *args != ' ') ++args;
+    if (*args) *args++ = '\0';
+    while (*args == ' ') ++args;
+
+    for (uint8_t i = 0; i < COMMAND_COUNT; ++i) {
+      const char* name = (const char*)pgm_read_ptr(&COMMANDS[i].name);
+      if (strcmp_P(text, name) == 0) {
+        Handler fn = (Handler)pgm_read_ptr(&COMMANDS[i].fn);
+        fn(args);
+        return;
+      }
+    }
+    Serial.print(F("? "));
+    Serial.println(text);
+  }
+}
+
+void begin() {
+  lineLen = 0;
+  overflow = false;
+  pressLen = 0;
+}
+
+void poll() {
+  // One queued press per call, so each lands in its own loop pass
+  if (pressHead < pressLen && (millis() - pressAt) >= pressGapMs) {
+    pressAt = millis();
+    if (!ReactorButtons::inject(presses[pressHead++])) Serial.println(F("? button"));
+  }
+
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c == '\r' || c == '\n') {
+      bool ran = false;
+      if (overflow) {
+        Serial.println(F("? line too long"));
+      } else if (lineLen > 0) {
+        line[lineLen] = '\0';
+        execute(line);
+        ran = true;
+      }
+      lineLen = 0;
+      overflow = false;
+      if (ran) break;  // at most one command per loop; the rest waits in RX
+    } else if (lineLen < LINE_MAX - 1) {
+      line[lineLen++] = c;
+    } else {
+      overflow = true;
+    }
+  }
+}
+
+bool idle() {
+  return !lineLen && pressHead >= pressLen && Serial.available() <= 0;
+}
+
+} // namespace ReactorConsole
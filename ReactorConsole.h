@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorConsole {
+
+void begin();
+
+// Read the Serial RX buffer up to and including the next complete line and
+// run it; at most one command per call. Also feeds one queued "press" code
+// to the buttons. Never blocks waiting for input.
+void poll();
+
+// Nothing buffered, queued or waiting in RX (safe to power down)
+bool idle();
+
+} // namespace ReactorConsole
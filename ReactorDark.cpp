@@ -1,6 +1,18 @@
 #include "ReactorDark.h"
 #include "ReactorUI.h"
 #include "ReactorHeat.h"
+#include "ReactorLeds.h"
+#include "ReactorAudio.h"
+#include "ReactorButtons.h"
+#include "ReactorConsole.h"
+#include "ReactorEvents.h"
+#include "ReactorReplay.h"
+#include "ReactorFuzz.h"
+#include "ReactorDiag.h"
+#include "ReactorTelemetry.h"
+#include "ReactorMirror.h"
+#include <avr/sleep.h>
+#include <avr/eeprom.h>
 
 namespace ReactorDark {
 
@@ -11,18 +23,69 @@ const unsigned long DARK_SUCCESS_DISPLAY_MS = 2000;
 unsigned long darkModeStartAt = 0;
 bool          darkModeShowingSuccess = true;
 
-// ======================= Pins =======================
-const uint8_t PIN_LED_MELTDOWN      = 13;
-const uint8_t PIN_LED_STABLE        = 12;
-const uint8_t PIN_LED_STARTUP       = 11;
-const uint8_t PIN_LED_FREEZEDOWN    = 9;
+// ======================= Power-Down =======================
+// Telemetry and the mirror run off millis() and the USART, which power-down
+// stops; while either is on, DARK only idles between Timer0 ticks. Idle also
+// keeps Serial RX alive, which cannot wake the MCU from power-down.
+static bool streaming() {
+  return ReactorTelemetry::active() || ReactorMirror::active();
+}
+
+// Anything that would stall or be lost while the clock is stopped keeps us
+// awake; millis() also stops, so timers resume where they left off.
+static bool canSleep() {
+  return !darkModeShowingSuccess
+      && ReactorButtons::idle()
+      && ReactorConsole::idle()
+      && !ReactorEvents::isActive()
+      && !ReactorReplay::isPlaying()
+      && !ReactorFuzz::running()
+      && eeprom_is_ready();
+}
+
+// Panel, LEDs, heat bar and buzzer off, then power-down until a Startup
+// edge. Returns with the panel on again (still black); the debouncer then
+// sees the press and the table moves on to STARTUP.
+static void sleepUntilStartup() {
+  ReactorLeds::statusOff();
+  ReactorHeat::allOff();
+  ReactorLeds::commit();
+  ReactorAudio::off();
+  ReactorUI::display.ssd1306_command(SSD1306_DISPLAYOFF);
+  Serial.flush();
+
+  uint8_t adcsra = ADCSRA;
+  ADCSRA &= ~_BV(ADEN);
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+
+  // Arm with interrupts off so a press from here on still wakes the
+  // sleep_cpu() below (sei lets one more instruction run first)
+  cli();
+  ReactorButtons::wakeOnStartup(true);
+  if (digitalRead(ReactorButtons::startupBtn.pin) == HIGH) {
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+  }
+  sei();
+  ReactorButtons::wakeOnStartup(false);
+
+  ADCSRA = adcsra;
+  ReactorDiag::sleepWoke();
+  ReactorUI::display.ssd1306_command(SSD1306_DISPLAYON);
+}
+
+// CPU off until the next interrupt (Timer0 within ~1 ms, or Serial RX)
+static void idleUntilInterrupt() {
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_enable();
+  sleep_cpu();
+  sleep_disable();
+}
 
 // ======================= API =======================
 void begin() {
-  pinMode(PIN_LED_MELTDOWN, OUTPUT);
-  pinMode(PIN_LED_STABLE, OUTPUT);
-  pinMode(PIN_LED_STARTUP, OUTPUT);
-  pinMode(PIN_LED_FREEZEDOWN, OUTPUT);
   reset();
 }
 
@@ -30,13 +93,10 @@ void reset() {
   darkModeStartAt = millis();
   darkModeShowingSuccess = false;
   
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   ReactorHeat::allOff();
   ReactorUI::display.clearDisplay();
-  ReactorUI::display.display();
+  ReactorUI::flush();
 }
 
 void enterDarkWithSuccess() {
@@ -51,7 +111,7 @@ void enterDarkWithSuccess() {
   ReactorUI::display.println("SHUTDOWN");
   ReactorUI::display.setCursor(12, 40);
   ReactorUI::display.println("SUCCESS");
-  ReactorUI::display.display();
+  ReactorUI::flush();
   
   // LEDs stay on momentarily (will turn off in tick)
 }
@@ -65,20 +125,20 @@ void tick() {
     darkModeShowingSuccess = false;
     
     // Turn everything off
-    digitalWrite(PIN_LED_MELTDOWN, LOW);
-    digitalWrite(PIN_LED_STABLE, LOW);
-    digitalWrite(PIN_LED_STARTUP, LOW);
-    digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+    ReactorLeds::statusOff();
     
     // Turn off all heat bar LEDs
     ReactorHeat::allOff();
     
     // Clear and turn off display
     ReactorUI::display.clearDisplay();
-    ReactorUI::display.display();
+    ReactorUI::flush();
   }
   
   // Stay dark - only startup button will wake us up
+  if (!canSleep()) return;
+  if (streaming()) idleUntilInterrupt();
+  else             sleepUntilStartup();
 }
 
 } // namespace ReactorDark
@@ -0,0 +1,364 @@
+#include "ReactorDiag.h"
+#include "ReactorStateMachine.h"
+#include "ReactorUI.h"
+
+// avr-libc heap bounds (linker symbol / malloc break)
+extern char  __heap_start;
+extern char* __brkval;
+
+namespace ReactorDiag {
+
+namespace {
+  // Per-mode loop counts and the wall time spent in each mode
+  uint32_t      modeLoops[MODE_COUNT];
+  uint32_t      modeDwellMs[MODE_COUNT];
+  unsigned long lastLoopAt = 0;
+
+  // Loop period histogram; the first pass after a reset only primes the clock
+  uint32_t      hist[HIST_BUCKETS];
+  unsigned long lastLoopUs = 0;
+  bool          histPrimed = false;
+  uint32_t      maxLoopUs = 0;
+  uint8_t       maxLoopMode = 0;
+
+  Window        window;
+
+  // Power-down sleeps and the wake-to-frame latency of the ones that ended
+  // with a frame (a stray edge just goes back to sleep and overwrites wakeUs)
+  uint32_t      sleeps = 0;
+  uint16_t      resumes = 0;
+  bool          wakePending = false;
+  unsigned long wakeUs = 0;
+  uint32_t      lastWakeUs = 0;
+  uint32_t      maxWakeUs = 0;
+  uint16_t      overBudget = 0;
+
+  bool          screenOn = false;
+
+  // Stack painting: bytes between the heap top and the boot SP hold the canary
+  // until the stack reaches them. scanCursor walks up a few bytes per loop.
+  const uint8_t STACK_CANARY   = 0xC5;
+  const uint8_t STACK_MARGIN   = 32;   // left unpainted under begin()'s frame
+  const uint8_t SCAN_PER_LOOP  = 64;
+  uint8_t*      lowWater = 0;
+  uint8_t*      scanCursor = 0;
+
+  inline uint8_t* heapTop() {
+    return (uint8_t*)(__brkval ? __brkval : &__heap_start);
+  }
+
+  void paintStack() {
+    uint8_t* end = (uint8_t*)SP - STACK_MARGIN;
+    for (uint8_t* p = heapTop(); p < end; ++p) *p = STACK_CANARY;
+    lowWater = end;
+    scanCursor = heapTop();
+  }
+
+  // The first touched byte above the heap is the deepest the stack has been
+  void scanStack() {
+    uint8_t* bottom = heapTop();
+    if (scanCursor < bottom) scanCursor = bottom;
+    for (uint8_t i = 0; i < SCAN_PER_LOOP; ++i, ++scanCursor) {
+      if (scanCursor >= lowWater || *scanCursor != STACK_CANARY) {
+        if (scanCursor < lowWater) lowWater = scanCursor;
+        scanCursor = bottom;
+        return;
+      }
+    }
+  }
+
+  uint8_t log2Bucket(uint32_t us) {
+    uint8_t b = 0;
+    while (us > 1 && b < HIST_BUCKETS - 1) { us >>= 1; ++b; }
+    return b;
+  }
+
+  uint8_t bitLength(uint32_t v) {
+    uint8_t n = 0;
+    while (v) { v >>= 1; ++n; }
+    return n;
+  }
+
+  void printMaxLoop(Print& out) {
+    out.print(maxLoopUs);
+    out.print(F(" us in "));
+    out.println(ReactorStateMachine::modeName(maxLoopMode));
+  }
+
+#ifdef REACTOR_PROFILE
+  struct CycleStat {
+    uint32_t n;
+    uint64_t sum;
+    uint32_t max;
+  };
+  CycleStat tickStats[MODE_COUNT];
+  CycleStat probeStats[PROBE_COUNT];
+
+  volatile uint16_t t1Overflows = 0;
+
+  void addStat(CycleStat& s, uint32_t c) {
+    ++s.n;
+    s.sum += c;
+    if (c > s.max) s.max = c;
+  }
+
+  void printStat(Print& out, const __FlashStringHelper* name, const CycleStat& s) {
+    if (!s.n) return;
+    out.print(name);
+    out.print(' ');
+    out.print(s.n);
+    out.print(' ');
+    out.print((unsigned long)(s.sum / s.n));
+    out.print(' ');
+    out.println(s.max);
+  }
+#endif
+}
+
+#ifdef REACTOR_PROFILE
+// Timer1 at clk/1 wraps every 4.096 ms; the overflow count extends it to 32 bits
+ISR(TIMER1_OVF_vect) {
+  ++t1Overflows;
+}
+
+uint32_t cycles() {
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t lo = TCNT1;
+  uint16_t hi = t1Overflows;
+  // Overflow pending but not yet serviced: TCNT1 already wrapped
+  if ((TIFR1 & _BV(TOV1)) && lo < 0x8000) ++hi;
+  SREG = sreg;
+  return ((uint32_t)hi << 16) | lo;
+}
+
+void addCycles(Probe probe, uint32_t c) {
+  addStat(probeStats[probe], c);
+}
+#endif
+
+void begin() {
+  paintStack();
+#ifdef REACTOR_PROFILE
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);
+  TCNT1  = 0;
+  TIFR1  = _BV(TOV1);
+  TIMSK1 = _BV(TOIE1);
+#endif
+  resetLoopRates();
+  resetHistogram();
+  resetCycles();
+}
+
+void loopDone(Mode mode, uint32_t tickCycles) {
+  unsigned long now = millis();
+  modeDwellMs[mode] += now - lastLoopAt;
+  lastLoopAt = now;
+  ++modeLoops[mode];
+
+  unsigned long nowUs = micros();
+  if (histPrimed) {
+    uint32_t us = nowUs - lastLoopUs;
+    ++hist[log2Bucket(us)];
+    if (us > maxLoopUs) { maxLoopUs = us; maxLoopMode = mode; }
+    if (window.loops != 0xFFFF) ++window.loops;
+    window.sumLoopUs += us;
+    if (us > window.maxLoopUs) window.maxLoopUs = us;
+  }
+  lastLoopUs = nowUs;
+  histPrimed = true;
+
+  scanStack();
+#ifdef REACTOR_PROFILE
+  addStat(tickStats[mode], tickCycles);
+#else
+  (void)tickCycles;
+#endif
+}
+
+void frameDone(uint32_t us) {
+  if (us > window.maxFrameUs) window.maxFrameUs = us;
+}
+
+void takeWindow(Window& w) {
+  w = window;
+  memset(&window, 0, sizeof(window));
+}
+
+void sleepWoke() {
+  wakeUs = micros();
+  wakePending = true;
+  ++sleeps;
+}
+
+void panelShown() {
+  if (!wakePending) return;
+  wakePending = false;
+  lastWakeUs = micros() - wakeUs;
+  if (lastWakeUs > maxWakeUs) maxWakeUs = lastWakeUs;
+  if (lastWakeUs > WAKE_BUDGET_US) ++overBudget;
+  ++resumes;
+}
+
+void resetSleep() {
+  sleeps = 0;
+  resumes = 0;
+  lastWakeUs = 0;
+  maxWakeUs = 0;
+  overBudget = 0;
+}
+
+void printSleep(Print& out) {
+  out.println(F("# sleeps resumes last_us max_us over_budget"));
+  out.print(sleeps);
+  out.print(' ');
+  out.print(resumes);
+  out.print(' ');
+  out.print(lastWakeUs);
+  out.print(' ');
+  out.print(maxWakeUs);
+  out.print(' ');
+  out.println(overBudget);
+}
+
+void resetLoopRates() {
+  for (uint8_t i = 0; i < MODE_COUNT; ++i) {
+    modeLoops[i] = 0;
+    modeDwellMs[i] = 0;
+  }
+  lastLoopAt = millis();
+}
+
+void printLoopRates(Print& out) {
+  out.println(F("# mode loops ms loops/s"));
+  for (uint8_t i = 0; i < MODE_COUNT; ++i) {
+    if (!modeLoops[i]) continue;
+    out.print(ReactorStateMachine::modeName(i));
+    out.print(' ');
+    out.print(modeLoops[i]);
+    out.print(' ');
+    out.print(modeDwellMs[i]);
+    out.print(' ');
+    out.println(modeDwellMs[i] ? (unsigned long)((uint64_t)modeLoops[i] * 1000 / modeDwellMs[i]) : 0UL);
+  }
+}
+
+void resetHistogram() {
+  memset(hist, 0, sizeof(hist));
+  maxLoopUs = 0;
+  maxLoopMode = 0;
+  histPrimed = false;
+}
+
+void printHistogram(Print& out) {
+  out.println(F("# from_us count"));
+  for (uint8_t i = 0; i < HIST_BUCKETS; ++i) {
+    if (!hist[i]) continue;
+    out.print(1UL << i);
+    out.print(' ');
+    out.println(hist[i]);
+  }
+  out.print(F("# max "));
+  printMaxLoop(out);
+}
+
+uint16_t freeRam() {
+  uint8_t* sp = (uint8_t*)SP;
+  uint8_t* top = heapTop();
+  return sp > top ? (uint16_t)(sp - top) : 0;
+}
+
+uint16_t minFreeStack() {
+  uint8_t* top = heapTop();
+  return lowWater > top ? (uint16_t)(lowWater - top) : 0;
+}
+
+void printMemory(Print& out) {
+  out.print(F("static "));
+  out.println((uint16_t)((uintptr_t)&__heap_start - RAMSTART));
+  out.print(F("heap "));
+  out.println((uint16_t)(heapTop() - (uint8_t*)&__heap_start));
+  out.print(F("stack_peak "));
+  out.println((uint16_t)(RAMEND - (uintptr_t)lowWater));
+  out.print(F("free_now "));
+  out.println(freeRam());
+  out.print(F("free_min "));
+  out.println(minFreeStack());
+}
+
+void toggleScreen() {
+  screenOn = !screenOn;
+}
+
+void hideScreen() {
+  screenOn = false;
+}
+
+bool screenActive() {
+  return screenOn;
+}
+
+// Log-scaled bar per bucket; ticks under 1 us, 1 ms and 1 s
+void renderScreen() {
+  Adafruit_SSD1306& d = ReactorUI::display;
+  const uint8_t BAR_W = 5, BASE_Y = 54, MAX_H = 34;
+
+  d.clearDisplay();
+  d.setTextSize(1);
+  d.setTextColor(SSD1306_WHITE);
+  d.setCursor(0, 0);
+  d.print(F("LOOP max "));
+  d.print(maxLoopUs);
+  d.print(F("us"));
+  d.setCursor(0, 9);
+  d.print(ReactorStateMachine::modeName(maxLoopMode));
+  d.print(F(" ram "));
+  d.print(minFreeStack());
+
+  uint8_t tallest = 1;
+  for (uint8_t i = 0; i < HIST_BUCKETS; ++i) {
+    uint8_t n = bitLength(hist[i]);
+    if (n > tallest) tallest = n;
+  }
+  for (uint8_t i = 0; i < HIST_BUCKETS; ++i) {
+    uint8_t h = (uint16_t)bitLength(hist[i]) * MAX_H / tallest;
+    if (h) d.fillRect(4 + i * BAR_W, BASE_Y - h, BAR_W - 1, h, SSD1306_WHITE);
+  }
+  d.drawFastHLine(4, BASE_Y, HIST_BUCKETS * BAR_W, SSD1306_WHITE);
+  d.setCursor(4, 56);           d.print(F("1us"));
+  d.setCursor(4 + 10 * BAR_W, 56); d.print(F("1ms"));
+  d.setCursor(4 + 20 * BAR_W, 56); d.print(F("1s"));
+
+  ReactorUI::flush();
+}
+
+void resetCycles() {
+#ifdef REACTOR_PROFILE
+  memset(tickStats, 0, sizeof(tickStats));
+  memset(probeStats, 0, sizeof(probeStats));
+#endif
+}
+
+void printCycles(Print& out) {
+#ifdef REACTOR_PROFILE
+  out.println(F("# probe n mean_cycles max_cycles"));
+  uint8_t worstMode = 0;
+  for (uint8_t i = 0; i < MODE_COUNT; ++i) {
+    printStat(out, ReactorStateMachine::modeName(i), tickStats[i]);
+    if (tickStats[i].max > tickStats[worstMode].max) worstMode = i;
+  }
+  printStat(out, F("frame"), probeStats[PROBE_FRAME]);
+  printStat(out, F("flush"), probeStats[PROBE_FLUSH]);
+  out.print(F("# worst loop "));
+  out.print(tickStats[worstMode].max);
+  out.print(F(" cycles ("));
+  out.print(tickStats[worstMode].max / (F_CPU / 1000000UL));
+  out.print(F(" us) in "));
+  out.println(ReactorStateMachine::modeName(worstMode));
+#else
+  out.println(F("cycle probes not built (-DREACTOR_PROFILE)"));
+#endif
+}
+
+} // namespace ReactorDiag
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ReactorTypes.h"
+
+namespace ReactorDiag {
+
+// Paints free SRAM for the stack high-water mark; call first in begin()
+void begin();
+
+// Call once at the end of every main loop pass with the mode it ended in and
+// the CPU cycles the pass took (0 when cycle probes are compiled out).
+// Also times the loop-to-loop period with micros() for the histogram.
+void loopDone(Mode mode, uint32_t tickCycles);
+
+// Loop and frame figures since the previous takeWindow() (telemetry)
+struct Window {
+  uint16_t loops;
+  uint32_t sumLoopUs;
+  uint32_t maxLoopUs;
+  uint32_t maxFrameUs;
+};
+void frameDone(uint32_t us);   // one active-frame repaint took us
+void takeWindow(Window& w);    // copy and restart the window
+
+// Loop iterations, dwell time and iterations/second per mode
+void printLoopRates(Print& out);
+void resetLoopRates();
+
+// ---- Loop period histogram: bucket i counts [2^i, 2^(i+1)) us, last is open ----
+const uint8_t HIST_BUCKETS = 24;
+void printHistogram(Print& out);
+void resetHistogram();
+
+// ---- Power-down in MODE_DARK: Startup press to first frame on the panel ----
+const uint32_t WAKE_BUDGET_US = 100000;
+void sleepWoke();    // call right after the MCU resumes from power-down
+void panelShown();   // a frame reached the panel (ReactorUI flush paths)
+void printSleep(Print& out);
+void resetSleep();
+
+// ---- SRAM headroom: stack painted at boot, low-water mark scanned each loop ----
+uint16_t freeRam();        // heap top to SP right now
+uint16_t minFreeStack();   // painted bytes the stack has never reached
+void printMemory(Print& out);
+
+// ---- Hidden diagnostics screen (hold ACK and press EVENT to toggle) ----
+void toggleScreen();
+void hideScreen();
+bool screenActive();
+void renderScreen();
+
+// ---- Cycle probes (-DREACTOR_PROFILE; claims Timer1 as a cycle counter) ----
+// Counted on the board rather than under an AVR simulator: read them with the
+// 'cycles' console command. The host build (host/) runs Timer1 off its
+// virtual clock at 16 MHz ('make -C host cycles'): bus time is modelled, but
+// CPU work is host time, not AVR cycles.
+enum Probe {
+  PROBE_FRAME,   // one active-frame repaint, flush included
+  PROBE_FLUSH,   // framebuffer push to the panel
+  PROBE_COUNT
+};
+
+#ifdef REACTOR_PROFILE
+uint32_t cycles();
+void addCycles(Probe probe, uint32_t c);
+#else
+inline uint32_t cycles() { return 0; }
+inline void addCycles(Probe, uint32_t) {}
+#endif
+
+// Per-mode tick and per-probe cycle counts (mean / worst) and the worst loop
+void printCycles(Print& out);
+void resetCycles();
+
+} // namespace ReactorDiag
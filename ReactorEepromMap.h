@@ -0,0 +1,17 @@
+#pragma once
+
+// EEPROM layout shared by every module that persists data (ATmega2560: 4 KB).
+// Regions must not overlap; keep them in address order.
+namespace ReactorEepromMap {
+  // Trace snapshot taken on MELTDOWN/CHAOS entry (header + record ring)
+  const int TRACE_BASE = 0x0100;
+  const int TRACE_END  = 0x0210;
+
+  // Persistent statistics: log of 16 x 64-byte slots, written round-robin
+  const int STATS_BASE = 0x0210;
+  const int STATS_END  = 0x0610;
+
+  // Tunable overrides (header, one word per tunable, CRC)
+  const int TUNE_BASE  = 0x0610;
+  const int TUNE_END   = 0x0640;
+}
@@ -1,6 +1,11 @@
 #include "ReactorEvents.h"
 #include "ReactorAudio.h"
 #include "ReactorUI.h"
+#include "ReactorLeds.h"
+#include "ReactorTrace.h"
+#include "ReactorRandom.h"
+#include "ReactorStats.h"
+#include "ReactorTunables.h"
 
 namespace ReactorEvents {
 
@@ -13,24 +18,284 @@ namespace {
     EVENT_CONTROL_ROD_JAM
   };
 
-  EventType activeEvent = EVENT_NONE;
-  char requiredButton = 0;  // 'O', 'S', 'U', 'F', 'D', 'E'
-  unsigned long eventStartAt = 0;
-  
-  const unsigned long EVENT_TIMEOUT_MS = 8000;  // 8 seconds to respond
-  const unsigned long EVENT_ALARM_PERIOD_MS = 300;
-  const int EVENT_ALARM_LOW_HZ = 900;
-  const int EVENT_ALARM_HIGH_HZ = 1400;
+  // ---- Incident catalogue (flash) ----
+  // weight:     relative odds of trigger() picking this type
+  // timeoutPct: time to respond before the incident fails, as a percentage
+  //             of the event_timeout_ms tunable
+  // alarmMs:    alarm tone cadence while this is the most urgent incident
+  // escalateMs: age at which an unresolved incident escalates (0 = never)
+  // spawns:     follow-on incident opened on escalation (EVENT_NONE = none)
+  struct EventDef {
+    uint8_t  type;
+    uint8_t  weight;
+    uint8_t  timeoutPct;
+    uint16_t alarmMs;
+    uint16_t lowHz;
+    uint16_t highHz;
+    uint16_t escalateMs;
+    uint8_t  spawns;
+  };
+
+  // A spike has to be caught quickly, a faulty sensor can wait; every
+  // escalating type escalates before it would fail
+  const EventDef CATALOGUE[] PROGMEM = {
+    { EVENT_COOLANT_LEAK,    3, 100, 300,  900, 1400, 4000, EVENT_PRESSURE_SPIKE },
+    { EVENT_PRESSURE_SPIKE,  2,  60, 200, 1100, 1700, 3000, EVENT_NONE },
+    { EVENT_SENSOR_FAULT,    2, 150, 450,  700, 1000,    0, EVENT_NONE },
+    { EVENT_CONTROL_ROD_JAM, 1,  75, 300,  900, 1400, 5000, EVENT_NONE }
+  };
+  const uint8_t CATALOGUE_COUNT = sizeof(CATALOGUE) / sizeof(CATALOGUE[0]);
+
+  const char BUTTONS[] = {'O', 'S', 'U', 'F', 'D', 'E'};
+  const uint8_t BUTTON_COUNT = sizeof(BUTTONS);
+
+  // ---- Live incidents ----
+  const uint8_t MAX_INCIDENTS = 3;
+
+  struct Incident {
+    uint8_t type;            // EVENT_NONE = free slot
+    uint8_t def;             // index into CATALOGUE
+    char requiredButton;     // 'O', 'S', 'U', 'F', 'D', 'E'
+    bool escalated;
+  };
+  Incident incidents[MAX_INCIDENTS];
+
+  // ---- Deadline heap ----
+  // Every live incident owns a fail deadline and, if its type escalates, an
+  // escalation deadline. The earliest one sits at heap[0], so tick() only
+  // ever compares against the top however many incidents are live.
+  enum DeadlineKind : uint8_t { DL_ESCALATE, DL_FAIL };
+
+  struct Deadline {
+    unsigned long at;
+    uint8_t slot;
+    uint8_t kind;
+  };
+  Deadline heap[MAX_INCIDENTS * 2];
+  uint8_t heapSize = 0;
+
+  // Most urgent incident (earliest fail deadline); drives UI and alarm
+  int8_t primary = -1;
+  unsigned long primaryFailAt = 0;
+
   const unsigned long EVENT_LED_BLINK_MS = 200;
-  
+
   unsigned long eventAlarmAt = 0;
   bool eventAlarmHigh = false;
   unsigned long eventLedBlinkAt = 0;
   bool eventLedOn = false;
+
+  // Wrap-safe "a is earlier than b"
+  inline bool before(unsigned long a, unsigned long b) {
+    return (long)(a - b) < 0;
+  }
+
+  void heapSwap(uint8_t a, uint8_t b) {
+    Deadline t = heap[a];
+    heap[a] = heap[b];
+    heap[b] = t;
+  }
+
+  void siftUp(uint8_t i) {
+    while (i > 0) {
+      uint8_t parent = (i - 1) / 2;
+      if (!before(heap[i].at, heap[parent].at)) break;
+      heapSwap(i, parent);
+      i = parent;
+    }
+  }
+
+  void siftDown(uint8_t i) {
+    for (;;) {
+      uint8_t l = 2 * i + 1;
+      uint8_t r = l + 1;
+      uint8_t m = i;
+      if (l < heapSize && before(heap[l].at, heap[m].at)) m = l;
+      if (r < heapSize && before(heap[r].at, heap[m].at)) m = r;
+      if (m == i) break;
+      heapSwap(i, m);
+      i = m;
+    }
+  }
+
+  void heapPush(unsigned long at, uint8_t slot, uint8_t kind) {
+    if (heapSize >= sizeof(heap) / sizeof(heap[0])) return;
+    heap[heapSize] = { at, slot, kind };
+    siftUp(heapSize++);
+  }
+
+  void heapRemoveAt(uint8_t i) {
+    heap[i] = heap[--heapSize];
+    if (i < heapSize) {
+      siftUp(i);
+      siftDown(i);
+    }
+  }
+
+  // Drop every deadline owned by a slot (at most two; small linear scan)
+  void heapRemoveSlot(uint8_t slot) {
+    for (uint8_t i = 0; i < heapSize; ) {
+      if (heap[i].slot == slot) heapRemoveAt(i);
+      else i++;
+    }
+  }
+
+  // Re-pick the incident with the earliest fail deadline
+  void choosePrimary() {
+    int8_t prev = primary;
+    primary = -1;
+    for (uint8_t i = 0; i < heapSize; i++) {
+      if (heap[i].kind != DL_FAIL) continue;
+      if (primary < 0 || before(heap[i].at, primaryFailAt)) {
+        primary = heap[i].slot;
+        primaryFailAt = heap[i].at;
+      }
+    }
+    if (primary != prev) {
+      eventAlarmAt = millis();
+      eventAlarmHigh = false;
+    }
+  }
+
+  bool buttonInUse(char b) {
+    for (uint8_t i = 0; i < MAX_INCIDENTS; i++) {
+      if (incidents[i].type != EVENT_NONE && incidents[i].requiredButton == b) return true;
+    }
+    return false;
+  }
+
+  // Random button not already claimed by another live incident
+  char pickButton() {
+    uint8_t i = ReactorRandom::below(BUTTON_COUNT);
+    for (uint8_t n = 0; n < BUTTON_COUNT && buttonInUse(BUTTONS[i]); n++) {
+      i = (i + 1) % BUTTON_COUNT;
+    }
+    return BUTTONS[i];
+  }
+
+  // Weighted pick over the catalogue
+  uint8_t pickDef() {
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < CATALOGUE_COUNT; i++) total += pgm_read_byte(&CATALOGUE[i].weight);
+    long r = ReactorRandom::below(total);
+    for (uint8_t i = 0; i < CATALOGUE_COUNT; i++) {
+      r -= pgm_read_byte(&CATALOGUE[i].weight);
+      if (r < 0) return i;
+    }
+    return CATALOGUE_COUNT - 1;
+  }
+
+  const char* kindName(uint8_t type) {
+    switch (type) {
+      case EVENT_COOLANT_LEAK:    return PSTR("leak");
+      case EVENT_PRESSURE_SPIKE:  return PSTR("spike");
+      case EVENT_SENSOR_FAULT:    return PSTR("sensor");
+      case EVENT_CONTROL_ROD_JAM: return PSTR("jam");
+      default:                    return PSTR("");
+    }
+  }
+
+  uint8_t defForType(uint8_t type) {
+    for (uint8_t i = 0; i < CATALOGUE_COUNT; i++) {
+      if (pgm_read_byte(&CATALOGUE[i].type) == type) return i;
+    }
+    return 0;
+  }
+
+  // Open an incident from catalogue entry `def`; false if every slot is busy
+  bool open(uint8_t def) {
+    uint8_t slot = 0;
+    while (slot < MAX_INCIDENTS && incidents[slot].type != EVENT_NONE) slot++;
+    if (slot == MAX_INCIDENTS) return false;
+
+    unsigned long now = millis();
+    Incident& inc = incidents[slot];
+    inc.type = pgm_read_byte(&CATALOGUE[def].type);
+    inc.def = def;
+    inc.requiredButton = pickButton();
+    inc.escalated = false;
+
+    uint32_t timeoutMs = (uint32_t)ReactorTunables::get(ReactorTunables::TN_EVENT_TIMEOUT_MS) *
+                         pgm_read_byte(&CATALOGUE[def].timeoutPct) / 100;
+    heapPush(now + timeoutMs, slot, DL_FAIL);
+    uint16_t escalateMs = pgm_read_word(&CATALOGUE[def].escalateMs);
+    if (escalateMs) heapPush(now + escalateMs, slot, DL_ESCALATE);
+    choosePrimary();
+
+    ReactorTrace::record(ReactorTrace::TR_EVENT_TRIGGER, inc.requiredButton);
+    return true;
+  }
+
+  // Free a slot; hand the meltdown LED back once nothing is live
+  void close(uint8_t slot) {
+    incidents[slot].type = EVENT_NONE;
+    incidents[slot].requiredButton = 0;
+    heapRemoveSlot(slot);
+    choosePrimary();
+    if (primary < 0) {
+      eventLedOn = false;
+      ReactorLeds::release(ReactorLeds::OWNER_EVENT, ReactorLeds::LED_MELTDOWN);
+    }
+    ReactorLeds::commit();
+  }
+
+  void escalate(uint8_t slot) {
+    Incident& inc = incidents[slot];
+    inc.escalated = true;
+    uint8_t spawns = pgm_read_byte(&CATALOGUE[inc.def].spawns);
+    if (spawns != EVENT_NONE) open(defForType(spawns));
+  }
+
+  void resolveSlot(uint8_t slot) {
+    ReactorTrace::record(ReactorTrace::TR_EVENT_RESOLVE, incidents[slot].requiredButton);
+    ReactorStats::bump(ReactorStats::ST_EVENTS_RESOLVED);
+    close(slot);
+
+    // Success tone
+    ReactorAudio::toneHz(1600);
+    delay(80);
+    ReactorAudio::toneHz(1800);
+    delay(80);
+    ReactorAudio::off();
+
+    // Brief success message
+    ReactorUI::display.clearDisplay();
+    ReactorUI::display.setTextSize(2);
+    ReactorUI::display.setTextColor(SSD1306_WHITE);
+    ReactorUI::display.setCursor(20, 24);
+    ReactorUI::display.println("EVENT");
+    ReactorUI::display.setCursor(12, 42);
+    ReactorUI::display.println("RESOLVED");
+    ReactorUI::flush();
+    delay(600);
+  }
+
+  void failSlot(uint8_t slot) {
+    ReactorTrace::record(ReactorTrace::TR_EVENT_FAIL, incidents[slot].requiredButton);
+    ReactorStats::bump(ReactorStats::ST_EVENTS_FAILED);
+    close(slot);
+
+    // Warning tone
+    ReactorAudio::toneHz(800);
+    delay(150);
+    ReactorAudio::off();
+
+    // Brief failure message
+    ReactorUI::display.clearDisplay();
+    ReactorUI::display.setTextSize(2);
+    ReactorUI::display.setTextColor(SSD1306_WHITE);
+    ReactorUI::display.setCursor(28, 24);
+    ReactorUI::display.println("EVENT");
+    ReactorUI::display.setCursor(24, 42);
+    ReactorUI::display.println("FAILED!");
+    ReactorUI::flush();
+    delay(600);
+  }
 }
 
 const char* getMessage() {
-  switch (activeEvent) {
+  if (primary < 0) return "";
+  switch (incidents[primary].type) {
     case EVENT_COOLANT_LEAK:    return "COOLANT LEAK!";
     case EVENT_PRESSURE_SPIKE:  return "PRESSURE SPIKE!";
     case EVENT_SENSOR_FAULT:    return "SENSOR FAULT!";
@@ -40,7 +305,7 @@ const char* getMessage() {
 }
 
 const char* getRequiredButtonName() {
-  switch (requiredButton) {
+  switch (getRequiredButton()) {
     case 'O': return "OVERRIDE";
     case 'S': return "STABILIZE";
     case 'U': return "STARTUP";
@@ -52,16 +317,47 @@ const char* getRequiredButtonName() {
 }
 
 char getRequiredButton() {
-  return requiredButton;
+  return primary < 0 ? 0 : incidents[primary].requiredButton;
 }
 
 bool isActive() {
-  return activeEvent != EVENT_NONE;
+  return primary >= 0;
+}
+
+uint8_t activeCount() {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < MAX_INCIDENTS; i++) {
+    if (incidents[i].type != EVENT_NONE) n++;
+  }
+  return n;
+}
+
+void shapeCoreInputs(ReactorThermal::Inputs& in) {
+  for (uint8_t i = 0; i < MAX_INCIDENTS; i++) {
+    const Incident& inc = incidents[i];
+    switch (inc.type) {
+      case EVENT_COOLANT_LEAK:
+        // An unattended leak drains the loop and lets the core run hotter
+        in.flow >>= inc.escalated ? 4 : 2;
+        if (inc.escalated) in.power = (in.power > 223) ? 255 : in.power + 32;
+        break;
+      case EVENT_PRESSURE_SPIKE: {
+        uint8_t add = inc.escalated ? 96 : 64;
+        in.power = (in.power > 255 - add) ? 255 : in.power + add;
+        break;
+      }
+      case EVENT_CONTROL_ROD_JAM:
+        in.rods = ReactorThermal::rodPosition();
+        if (inc.escalated) in.rods = (in.rods < 32) ? 0 : in.rods - 32;
+        break;
+      default: break;
+    }
+  }
 }
 
 bool handleInput(bool overrideFell, bool stabilizeFell, bool startupFell,
                  bool freezedownFell, bool shutdownFell, bool eventFell) {
-  if (activeEvent == EVENT_NONE) return false;
+  if (primary < 0) return false;
 
   char pressed = 0;
   if (overrideFell)   pressed = 'O';
@@ -73,9 +369,12 @@ bool handleInput(bool overrideFell, bool stabilizeFell, bool startupFell,
 
   if (pressed == 0) return false;
 
-  if (pressed == requiredButton) {
-    resolve();
-    return true;
+  // Any live incident may be cleared, not only the one on screen
+  for (uint8_t i = 0; i < MAX_INCIDENTS; i++) {
+    if (incidents[i].type != EVENT_NONE && incidents[i].requiredButton == pressed) {
+      resolveSlot(i);
+      return true;
+    }
   }
 
   // Wrong button pressed during event - consume input
@@ -83,109 +382,78 @@ bool handleInput(bool overrideFell, bool stabilizeFell, bool startupFell,
 }
 
 void begin() {
-  activeEvent = EVENT_NONE;
-  requiredButton = 0;
-  eventStartAt = 0;
+  for (uint8_t i = 0; i < MAX_INCIDENTS; i++) {
+    incidents[i].type = EVENT_NONE;
+    incidents[i].requiredButton = 0;
+  }
+  heapSize = 0;
+  primary = -1;
   eventAlarmAt = millis();
   eventAlarmHigh = false;
   eventLedBlinkAt = millis();
   eventLedOn = false;
 }
 
-void trigger() {
-  // Pick a random event type
-  EventType events[] = {
-    EVENT_COOLANT_LEAK,
-    EVENT_PRESSURE_SPIKE,
-    EVENT_SENSOR_FAULT,
-    EVENT_CONTROL_ROD_JAM
-  };
-  activeEvent = events[random(4)];
-  
-  // Assign a random button
-  char buttons[] = {'O', 'S', 'U', 'F', 'D', 'E'};
-  requiredButton = buttons[random(6)];
-  
-  eventStartAt = millis();
-  eventAlarmAt = millis();
-  eventAlarmHigh = false;
+static bool start(uint8_t def) {
+  if (!open(def)) return false;
+
   eventLedBlinkAt = millis();
   eventLedOn = false;
-  
+  ReactorLeds::set(ReactorLeds::OWNER_EVENT, ReactorLeds::LED_MELTDOWN, false);
+
   // Brief alarm chirp
   ReactorAudio::toneHz(1200);
   delay(100);
   ReactorAudio::off();
+  return true;
+}
+
+bool trigger() {
+  return start(pickDef());
+}
+
+bool trigger(const char* kind) {
+  for (uint8_t i = 0; i < CATALOGUE_COUNT; ++i) {
+    if (strcmp_P(kind, kindName(pgm_read_byte(&CATALOGUE[i].type))) == 0) return start(i);
+  }
+  return false;
 }
 
 void resolve() {
-  activeEvent = EVENT_NONE;
-  requiredButton = 0;
-  digitalWrite(13, LOW);  // Turn off meltdown LED (PIN_LED_MELTDOWN = 13)
-  
-  // Success tone
-  ReactorAudio::toneHz(1600);
-  delay(80);
-  ReactorAudio::toneHz(1800);
-  delay(80);
-  ReactorAudio::off();
-  
-  // Brief success message
-  ReactorUI::display.clearDisplay();
-  ReactorUI::display.setTextSize(2);
-  ReactorUI::display.setTextColor(SSD1306_WHITE);
-  ReactorUI::display.setCursor(20, 24);
-  ReactorUI::display.println("EVENT");
-  ReactorUI::display.setCursor(12, 42);
-  ReactorUI::display.println("RESOLVED");
-  ReactorUI::display.display();
-  delay(600);
+  if (primary >= 0) resolveSlot(primary);
 }
 
 void fail() {
-  activeEvent = EVENT_NONE;
-  requiredButton = 0;
-  digitalWrite(13, LOW);  // Turn off meltdown LED
-  
-  // Warning tone
-  ReactorAudio::toneHz(800);
-  delay(150);
-  ReactorAudio::off();
-  
-  // Brief failure message
-  ReactorUI::display.clearDisplay();
-  ReactorUI::display.setTextSize(2);
-  ReactorUI::display.setTextColor(SSD1306_WHITE);
-  ReactorUI::display.setCursor(28, 24);
-  ReactorUI::display.println("EVENT");
-  ReactorUI::display.setCursor(24, 42);
-  ReactorUI::display.println("FAILED!");
-  ReactorUI::display.display();
-  delay(600);
+  if (primary >= 0) failSlot(primary);
 }
 
 void tick() {
+  if (primary < 0) return;
   unsigned long now = millis();
-  
-  // If event is active, check for timeout
-  if (activeEvent != EVENT_NONE) {
-    // Play alternating alarm tone
-    if (now - eventAlarmAt >= EVENT_ALARM_PERIOD_MS) {
-      eventAlarmAt = now;
-      eventAlarmHigh = !eventAlarmHigh;
-      ReactorAudio::toneHz(eventAlarmHigh ? EVENT_ALARM_HIGH_HZ : EVENT_ALARM_LOW_HZ);
-    }
-    
-    // Blink the meltdown LED
-    if (now - eventLedBlinkAt >= EVENT_LED_BLINK_MS) {
-      eventLedBlinkAt = now;
-      eventLedOn = !eventLedOn;
-      digitalWrite(13, eventLedOn ? HIGH : LOW);  // PIN_LED_MELTDOWN = 13
-    }
-    
-    if (now - eventStartAt >= EVENT_TIMEOUT_MS) {
-      fail();
-    }
+
+  // Play the most urgent incident's alternating alarm
+  uint8_t def = incidents[primary].def;
+  if (now - eventAlarmAt >= pgm_read_word(&CATALOGUE[def].alarmMs)) {
+    eventAlarmAt = now;
+    eventAlarmHigh = !eventAlarmHigh;
+    ReactorAudio::toneHz(eventAlarmHigh ? pgm_read_word(&CATALOGUE[def].highHz)
+                                        : pgm_read_word(&CATALOGUE[def].lowHz));
+  }
+
+  // Blink the meltdown LED
+  if (now - eventLedBlinkAt >= EVENT_LED_BLINK_MS) {
+    eventLedBlinkAt = now;
+    eventLedOn = !eventLedOn;
+    ReactorLeds::set(ReactorLeds::OWNER_EVENT, ReactorLeds::LED_MELTDOWN, eventLedOn);
+  }
+
+  // Only the heap top is compared; at most one deadline is handled per tick
+  // because failing blocks on its popup anyway
+  if (heapSize && !before(now, heap[0].at)) {
+    Deadline d = heap[0];
+    heapRemoveAt(0);
+    if (d.kind == DL_ESCALATE) escalate(d.slot);
+    else failSlot(d.slot);
   }
 }
 
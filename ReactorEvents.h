@@ -1,12 +1,24 @@
 #pragma once
 
 #include <Arduino.h>
+#include "ReactorThermal.h"
 
 namespace ReactorEvents {
 
 void begin();
 void tick();
-void trigger();
+
+// Open a new incident (weighted pick from the catalogue); false when full.
+// The EVENT button only gets here with nothing live (GUARD_NO_EVENT, and
+// handleInput() takes every press while an incident is open), so further
+// incidents come from escalation or the console.
+bool trigger();
+
+// Open a specific incident by short name: leak, spike, sensor, jam.
+// False if the name is unknown or every slot is busy.
+bool trigger(const char* kind);
+
+// Resolve or fail the most urgent incident
 void resolve();
 void fail();
 
@@ -14,7 +26,14 @@ void fail();
 bool handleInput(bool overrideFell, bool stabilizeFell, bool startupFell,
 				 bool freezedownFell, bool shutdownFell, bool eventFell);
 
+// True while any incident is live; the getters below describe the most
+// urgent one (earliest fail deadline)
 bool isActive();
+uint8_t activeCount();
+
+// Apply every live incident (escalated ones harder) to the core model's inputs
+void shapeCoreInputs(ReactorThermal::Inputs& in);
+
 const char* getMessage();
 const char* getRequiredButtonName();
 char getRequiredButton();
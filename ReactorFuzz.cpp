@@ -0,0 +1,200 @@
+#include "ReactorFuzz.h"
+#include "ReactorStateMachine.h"
+#include "ReactorLeds.h"
+#include "ReactorAudio.h"
+#include "ReactorButtons.h"
+#include "ReactorEvents.h"
+#include "ReactorTrace.h"
+#include "ReactorRandom.h"
+
+namespace ReactorFuzz {
+
+namespace {
+  uint16_t failCount[INV_COUNT];
+
+#ifdef REACTOR_CHECKS
+  // Slack past a mode's table timeout before it counts as stuck
+  const uint16_t TIMEOUT_GRACE_MS = 1000;
+
+  // Where each timed mode must end up when its window runs out, written out
+  // here rather than read back from the transition table it checks
+  const uint8_t NO_TARGET = 0xFF;
+  const uint8_t TIMED_TARGET[MODE_COUNT] PROGMEM = {
+    NO_TARGET,          // STABLE
+    MODE_CRITICAL,      // ARMING
+    MODE_MELTDOWN,      // CRITICAL
+    MODE_CHAOS,         // MELTDOWN
+    MODE_STABLE,        // STABILIZING
+    MODE_STABILIZING,   // STARTUP
+    MODE_STABLE,        // FREEZEDOWN
+    MODE_DARK,          // SHUTDOWN
+    NO_TARGET,          // DARK
+    NO_TARGET           // CHAOS
+  };
+
+  uint8_t       failing = 0;      // bit per invariant currently failing
+  uint8_t       seenMode = 0xFF;  // mode and entry time at the last check
+  unsigned long seenEnteredAt = 0;
+#endif
+
+#ifdef REACTOR_FUZZ
+  const char CODES[] = "OSUFDEA";
+  uint32_t      edgesLeft = 0;
+  uint32_t      edgesDone = 0;
+  unsigned long nextEdgeAt = 0;
+  uint8_t       burstLeft = 0;  // quick presses in a row (secret-sized bursts)
+  bool          ackHeld = false;
+  unsigned long ackReleaseAt = 0;
+  char          chordWith = 0;   // pressed next while ACK is down
+#endif
+
+#ifdef REACTOR_CHECKS
+  void report(Invariant inv, bool ok) {
+    uint8_t b = 1 << inv;
+    if (ok) { failing &= ~b; return; }
+    if (failing & b) return;
+    failing |= b;
+    if (failCount[inv] < 0xFFFF) ++failCount[inv];
+    ReactorTrace::record(ReactorTrace::TR_CHECK, inv);
+  }
+
+  // CHAOS scrambles the lamps on purpose
+  bool statusLedsExclusive() {
+    if (ReactorStateMachine::getMode() == MODE_CHAOS) return true;
+    uint8_t lit = 0;
+    for (uint8_t i = ReactorLeds::LED_MELTDOWN; i <= ReactorLeds::LED_FREEZEDOWN; ++i) {
+      if (ReactorLeds::wants(ReactorLeds::OWNER_MODE, (ReactorLeds::Led)i)) ++lit;
+    }
+    return lit <= 1;
+  }
+
+  bool timedModeOnTime(unsigned long now) {
+    uint16_t limit = ReactorStateMachine::timeoutMs(ReactorStateMachine::getMode());
+    if (limit == 0) return true;
+    return now - ReactorStateMachine::modeEnteredAt < (unsigned long)limit + TIMEOUT_GRACE_MS;
+  }
+
+  // Judged once per mode change, from the mode it left and the input that
+  // moved it; changes that bypassed the table (console, replay) are skipped
+  bool timedExitExpected() {
+    Mode mode = ReactorStateMachine::getMode();
+    if (mode == seenMode && ReactorStateMachine::modeEnteredAt == seenEnteredAt) return true;
+    uint8_t from = seenMode;
+    seenMode = mode;
+    seenEnteredAt = ReactorStateMachine::modeEnteredAt;
+    if (from >= MODE_COUNT) return true;
+
+    switch (ReactorStateMachine::lastInput()) {
+      case ReactorStateMachine::IN_TIMEOUT:
+        return mode == pgm_read_byte(&TIMED_TARGET[from]);
+      case ReactorStateMachine::IN_HEAT_CRITICAL:
+        return from == MODE_STABILIZING && ReactorEvents::isActive();
+      default:
+        return true;
+    }
+  }
+#endif
+}
+
+#ifdef REACTOR_CHECKS
+void checkInvariants(unsigned long now) {
+  report(INV_STATUS_LEDS,  statusLedsExclusive());
+  report(INV_MUTED_SILENT, !(ReactorAudio::isMuted() && ReactorAudio::isSounding()));
+  report(INV_MODE_TIMEOUT, timedModeOnTime(now));
+  report(INV_TIMED_EXIT,   timedExitExpected());
+}
+#endif
+
+void resetChecks() {
+  for (uint8_t i = 0; i < INV_COUNT; ++i) failCount[i] = 0;
+#ifdef REACTOR_CHECKS
+  failing = 0;
+#endif
+}
+
+uint16_t failures(Invariant inv) {
+  return failCount[inv];
+}
+
+void printChecks(Print& out) {
+#ifdef REACTOR_CHECKS
+  out.print(F("status_leds "));
+  out.println(failCount[INV_STATUS_LEDS]);
+  out.print(F("muted_silent "));
+  out.println(failCount[INV_MUTED_SILENT]);
+  out.print(F("mode_timeout "));
+  out.println(failCount[INV_MODE_TIMEOUT]);
+  out.print(F("timed_exit "));
+  out.println(failCount[INV_TIMED_EXIT]);
+#else
+  out.println(F("invariant checks not built (-DREACTOR_CHECKS)"));
+#endif
+#ifdef REACTOR_FUZZ
+  out.print(F("fuzz "));
+  out.print(edgesDone);
+  out.print(F(" done "));
+  out.print(edgesLeft);
+  out.println(F(" left"));
+#endif
+}
+
+#ifdef REACTOR_FUZZ
+void start(uint32_t edges) {
+  edgesLeft = edges;
+  edgesDone = 0;
+  burstLeft = 0;
+  chordWith = 0;
+  nextEdgeAt = millis();
+  if (ackHeld) ReactorButtons::hold('A', false);
+  ackHeld = false;
+}
+
+void tick() {
+  unsigned long now = millis();
+  if (ackHeld && (long)(now - ackReleaseAt) >= 0) {
+    ReactorButtons::hold('A', false);
+    ackHeld = false;
+  }
+  if (!edgesLeft) return;
+  if ((long)(now - nextEdgeAt) < 0) return;
+
+  char code = chordWith ? chordWith : CODES[ReactorRandom::below(sizeof(CODES) - 1)];
+  chordWith = 0;
+  --edgesLeft;
+  ++edgesDone;
+
+  // ACK stays down long enough for a chord: the next edge is usually EVENT
+  // or STABILIZE a moment later
+  if (code == 'A' && !ackHeld) {
+    ReactorButtons::hold('A', true);
+    ackHeld = true;
+    ackReleaseAt = now + ReactorRandom::range(300, 1500);
+    if (ReactorRandom::below(4) != 0) {
+      chordWith = ReactorRandom::coin() ? 'E' : 'S';
+      nextEdgeAt = now + ReactorRandom::range(60, 250);
+      return;
+    }
+  } else {
+    ReactorButtons::inject(code);
+  }
+
+  // Mostly slow, spread-out presses; sometimes a burst inside the secret window
+  if (!burstLeft && ReactorRandom::below(8) == 0) burstLeft = ReactorRandom::range(4, 7);
+  if (burstLeft) {
+    --burstLeft;
+    nextEdgeAt = now + ReactorRandom::range(60, 600);
+  } else {
+    nextEdgeAt = now + ReactorRandom::range(150, 6000);
+  }
+}
+
+bool running() {
+  return edgesLeft != 0 || ackHeld;
+}
+#else
+void start(uint32_t) {}
+void tick() {}
+bool running() { return false; }
+#endif
+
+} // namespace ReactorFuzz
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorFuzz {
+
+// ---- Invariants (-DREACTOR_CHECKS, implied by -DREACTOR_FUZZ) ----
+// Properties checked every loop; a newly failing one is counted and traced.
+// Without the flag the pass compiles to nothing.
+enum Invariant : uint8_t {
+  INV_STATUS_LEDS,   // the mode owner lights at most one status lamp (not in CHAOS)
+  INV_MUTED_SILENT,  // no tone is sounding inside a mute window
+  INV_MODE_TIMEOUT,  // a timed mode (e.g. MELTDOWN -> CHAOS) never outstays its window
+  INV_TIMED_EXIT,    // a timeout lands in the mode's own target, and STABILIZING
+                     // only aborts on a runaway while an incident drives the core
+  INV_COUNT
+};
+
+#if defined(REACTOR_FUZZ) && !defined(REACTOR_CHECKS)
+#define REACTOR_CHECKS
+#endif
+
+// Call once per loop before ReactorEvents::handleInput(), which may end the
+// pass early; a timeout due this pass is covered by the grace period
+#ifdef REACTOR_CHECKS
+void checkInvariants(unsigned long now);
+#else
+inline void checkInvariants(unsigned long) {}
+#endif
+
+// Failure counts per invariant and fuzz progress
+void printChecks(Print& out);
+void resetChecks();
+uint16_t failures(Invariant inv);
+
+// Random button edges at random gaps (-DREACTOR_FUZZ). ACK is held for a
+// while and is often followed by EVENT or STABILIZE, so the chords get
+// exercised. Injected edges are recorded like real presses, so a failing
+// run can be dumped as a session.
+void start(uint32_t edges);
+void tick();   // before ReactorButtons::update
+bool running();
+
+} // namespace ReactorFuzz
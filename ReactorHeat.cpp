@@ -1,76 +1,89 @@
 #include "ReactorHeat.h"
+#include "ReactorLeds.h"
+#include "ReactorTrace.h"
+#include "ReactorThermal.h"
+#include "ReactorRandom.h"
 
 namespace ReactorHeat {
 
 namespace {
   const uint8_t HEAT_COUNT = 12;
-  const uint8_t HEAT_PINS[HEAT_COUNT] = {
-    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33
-  };
-  const bool HEAT_ACTIVE_HIGH = true;
 
-  const unsigned long HEAT_TICK_MS = 40;       // ~25 FPS
-  const float         HEAT_SLEW_LVL_PER_S = 8; // levels/sec (0..12)
+  const unsigned long HEAT_TICK_MS = 40;       // fixed model step (~25 Hz)
+  const uint8_t       HEAT_MAX_CATCHUP = 25;   // steps replayed after a blocking call
 
-  float heatValue  = 2.0f;
-  float heatTarget = 2.0f;
   unsigned long heatTickAt = 0;
 
+  const uint8_t HISTORY_STEPS = HISTORY_STEP_MS / HEAT_TICK_MS;
+  uint8_t  history[HISTORY_LEN];
+  uint8_t  historyHead = 0;      // next slot to write
+  uint16_t historyTotal = 0;
+  uint8_t  stepsToSample = HISTORY_STEPS;
+  uint8_t heatBand = 0;  // lit / 3, traced when it changes
+
   inline void heatWrite(uint8_t idx, bool on) {
     if (idx >= HEAT_COUNT) return;
-    digitalWrite(HEAT_PINS[idx], (on ^ !HEAT_ACTIVE_HIGH) ? HIGH : LOW);
-  }
-
-  float clampLevel(float v) {
-    if (v < 0.0f) return 0.0f;
-    if (v > (float)HEAT_COUNT) return (float)HEAT_COUNT;
-    return v;
+    ReactorLeds::set(ReactorLeds::OWNER_MODE, (ReactorLeds::Led)(ReactorLeds::LED_HEAT_0 + idx), on);
   }
 }
 
 void begin() {
-  for (uint8_t i = 0; i < HEAT_COUNT; ++i) {
-    pinMode(HEAT_PINS[i], OUTPUT);
-    heatWrite(i, false);
-  }
+  // Pins are configured by ReactorLeds::begin()
+  allOff();
+  ReactorThermal::begin(2 << 8);
   heatTickAt = millis();
+  historyHead = 0;
+  historyTotal = 0;
+  stepsToSample = HISTORY_STEPS;
+  heatBand = 0;
 }
 
-void setTarget(float level) {
-  heatTarget = clampLevel(level);
+void setLevelQ8(uint16_t q8) {
+  ReactorThermal::setLevelQ8(q8);
 }
 
-void setLevel(float level) {
-  heatValue = clampLevel(level);
-  heatTarget = heatValue;
+uint16_t levelQ8() {
+  return ReactorThermal::levelQ8();
 }
 
-float getLevel() {
-  return heatValue;
+uint8_t litCount() {
+  return (uint8_t)((ReactorThermal::levelQ8() + 128) >> 8);
 }
 
+// Rounded level * 100 / 12; the model clamps the level to 0..12
 uint8_t percent() {
-  float pct = (heatValue / (float)HEAT_COUNT) * 100.0f;
-  if (pct < 0) pct = 0; if (pct > 100) pct = 100;
-  return (uint8_t)(pct + 0.5f);
+  const uint16_t fullQ8 = (uint16_t)HEAT_COUNT << 8;
+  return (uint8_t)(((uint32_t)ReactorThermal::levelQ8() * 100 + fullQ8 / 2) / fullQ8);
 }
 
 void tick(Mode mode) {
   unsigned long now = millis();
   if (now - heatTickAt < HEAT_TICK_MS) return;
-  float dt = (now - heatTickAt) / 1000.0f;
-  heatTickAt = now;
 
-  float maxDelta = HEAT_SLEW_LVL_PER_S * dt;
-  float delta = heatTarget - heatValue;
-  if (delta >  maxDelta) delta =  maxDelta;
-  if (delta < -maxDelta) delta = -maxDelta;
-  heatValue += delta;
+  // Fixed timestep; a long stall only replays a bounded number of steps
+  uint8_t steps = 0;
+  while (now - heatTickAt >= HEAT_TICK_MS && steps < HEAT_MAX_CATCHUP) {
+    ReactorThermal::step();
+    heatTickAt += HEAT_TICK_MS;
+    ++steps;
+    if (--stepsToSample == 0) {
+      stepsToSample = HISTORY_STEPS;
+      history[historyHead] = (uint8_t)(ReactorThermal::levelQ8() >> 4);
+      historyHead = (historyHead + 1) % HISTORY_LEN;
+      ++historyTotal;
+    }
+  }
+  if (now - heatTickAt >= HEAT_TICK_MS) heatTickAt = now;
+
+  uint8_t lit = litCount();
 
-  int lit = (int)roundf(heatValue);
-  if (lit < 0) lit = 0; if (lit > HEAT_COUNT) lit = HEAT_COUNT;
+  uint8_t band = lit / 3;
+  if (band != heatBand) {
+    heatBand = band;
+    ReactorTrace::record(ReactorTrace::TR_HEAT, band);
+  }
 
-  for (int i = 0; i < HEAT_COUNT; ++i) {
+  for (uint8_t i = 0; i < HEAT_COUNT; ++i) {
     bool on = (i < lit);
     heatWrite(i, on);
   }
@@ -88,13 +101,24 @@ void tick(Mode mode) {
   }
 }
 
+uint8_t historyAt(uint8_t age) {
+  if (age >= HISTORY_LEN || age >= historyTotal) return 0;
+  return history[(uint8_t)(historyHead + HISTORY_LEN - 1 - age) % HISTORY_LEN];
+}
+
+uint16_t historyCount() {
+  return historyTotal;
+}
+
 void allOff() {
   for (uint8_t i = 0; i < HEAT_COUNT; ++i) heatWrite(i, false);
 }
 
 void chaosFlicker() {
-  for (uint8_t i = 0; i < HEAT_COUNT; ++i) {
-    heatWrite(i, random(2));
+  // One generator step covers every segment
+  uint32_t bits = ReactorRandom::next();
+  for (uint8_t i = 0; i < HEAT_COUNT; ++i, bits >>= 1) {
+    heatWrite(i, bits & 1);
   }
 }
 
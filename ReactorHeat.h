@@ -5,12 +5,20 @@
 
 namespace ReactorHeat {
 
+// Heat is produced by ReactorThermal; ReactorHeatControl sets its inputs
 void begin();
-void setTarget(float level);       // desired level 0..12
-void setLevel(float level);        // force level instantly
-float getLevel();                  // current level (0..12)
+void setLevelQ8(uint16_t q8);      // force level instantly (Q8.8, 0..12)
+uint16_t levelQ8();                // current level (Q8.8, 0..12)
+uint8_t litCount();                // heat bar segments lit (level rounded)
 uint8_t percent();                 // 0..100 for UI
-void tick(Mode mode);              // apply slew + special blinks
+void tick(Mode mode);              // step the core model + special blinks
+// Trend history: one sample per HISTORY_STEP_MS of model time, level in
+// 1/16ths (0..192), kept for the last HISTORY_LEN samples (~4 minutes)
+const uint8_t  HISTORY_LEN     = 128;
+const uint16_t HISTORY_STEP_MS = 2000;
+uint8_t historyAt(uint8_t age);    // 0 = newest
+uint16_t historyCount();           // samples taken so far (wraps)
+
 void allOff();
 void chaosFlicker();
 
@@ -1,65 +1,152 @@
 #include "ReactorHeatControl.h"
 #include "ReactorHeat.h"
-#include "ReactorSequences.h"
+#include "ReactorThermal.h"
+#include "ReactorStateMachine.h"
+#include "ReactorEvents.h"
+#include "ReactorSecrets.h"
 
 namespace ReactorHeatControl {
 
-static void updateTargetForMode(Mode mode) {
-  float heatTarget = ReactorHeat::getLevel();
+namespace {
+  // ---- Easing curves: 17 points over the mode's timeout, 0..255 ----
+  enum Curve : uint8_t {
+    CURVE_EASE_IN_OUT,  // 3t^2 - 2t^3
+    CURVE_EASE_OUT,     // 1 - (1 - t)^2
+    CURVE_EXP,          // (1 - e^-4t) / (1 - e^-4): fast onset, exponential settle
+    CURVE_COUNT
+  };
+  const uint8_t CURVE_SEGMENTS = 16;
+
+  const uint8_t CURVES[CURVE_COUNT][CURVE_SEGMENTS + 1] PROGMEM = {
+    { 0,  3, 11,  24,  40,  59,  81, 104, 128, 151, 174, 196, 215, 231, 244, 252, 255 },
+    { 0, 31, 60,  87, 112, 134, 155, 174, 191, 206, 219, 230, 239, 246, 251, 254, 255 },
+    { 0, 57, 102, 137, 164, 185, 202, 215, 225, 232, 238, 243, 247, 250, 252, 254, 255 },
+  };
+
+  // One input swept from -> to along a curve over the mode's table timeout
+  enum Channel : uint8_t { CH_POWER, CH_RODS, CH_FLOW, CH_CRYO };
+
+  struct Ramp {
+    uint8_t mode;
+    uint8_t channel;
+    uint8_t from;
+    uint8_t to;
+    uint8_t curve;
+  };
+
+  const Ramp RAMPS[] PROGMEM = {
+    { MODE_ARMING,      CH_RODS,  102,   0, CURVE_EASE_IN_OUT },  // rods withdraw: 6..10
+    { MODE_STARTUP,     CH_POWER,  64, 193, CURVE_EASE_IN_OUT },  // power up: 3..9
+    { MODE_STABILIZING, CH_RODS,   38, 183, CURVE_EASE_OUT    },  // rods in: 9..3
+    { MODE_FREEZEDOWN,  CH_CRYO,    0, 160, CURVE_EXP         },  // cryo floods in: ~1
+    { MODE_SHUTDOWN,    CH_RODS,   63, 159, CURVE_EASE_IN_OUT },  // rods in: 6..3
+  };
+  const uint8_t RAMP_COUNT = sizeof(RAMPS) / sizeof(RAMPS[0]);
+
+  // Inputs for the current mode (ramped channel excluded); rebuilt on mode change
+  ReactorThermal::Inputs base;
+  uint8_t cachedMode = 0xFF;
+  int8_t  rampIdx = -1;
+
+  uint8_t& channelOf(ReactorThermal::Inputs& in, uint8_t ch) {
+    switch (ch) {
+      case CH_POWER: return in.power;
+      case CH_RODS:  return in.rods;
+      case CH_FLOW:  return in.flow;
+      default:       return in.cryo;
+    }
+  }
+
+  // Curve value (0..255) at elapsed / duration, linear between table points
+  uint8_t curveAt(uint8_t curve, unsigned long elapsed, uint16_t duration) {
+    if (duration == 0 || elapsed >= duration) return 255;
+    uint16_t pos = (uint32_t)elapsed * (CURVE_SEGMENTS << 8) / duration;  // segment in Q8
+    uint8_t seg = pos >> 8, frac = pos & 0xFF;
+    uint8_t a = pgm_read_byte(&CURVES[curve][seg]);
+    uint8_t b = pgm_read_byte(&CURVES[curve][seg + 1]);
+    return a + (((int16_t)b - a) * frac >> 8);
+  }
+}
+
+// Settled level is power * (255 - rods) / 256 / (8 + flow / 8 + cryo / 4),
+// so each mode's inputs below aim at the heat it used to be held at.
+// A mode with a ramp has that channel swept along its curve (see RAMPS).
+static void buildInputsForMode(Mode mode, ReactorThermal::Inputs& in) {
   switch (mode) {
     case MODE_STABLE:
-      heatTarget = 4.0f; // safe-ish idle
+      in.power = 128; in.rods = 128; in.flow = 64; in.cryo = 0;  // ~4 idle
       break;
 
-    case MODE_ARMING: {
-      uint8_t step = ReactorSequences::getStep(MODE_ARMING);
-      uint8_t total = ReactorSequences::getTotalSteps(MODE_ARMING);
-      float phase = (total > 0) ? (float)step / (float)total : 0.0f;
-      if (phase < 0) phase = 0; if (phase > 1) phase = 1;
-      heatTarget = 6.0f + 4.0f * phase; // 6..10
-      } break;
-
-    case MODE_STARTUP: {
-      uint8_t step = ReactorSequences::getStep(MODE_STARTUP);
-      uint8_t total = ReactorSequences::getTotalSteps(MODE_STARTUP);
-      float t = (total > 0) ? (float)step / (float)total : 0.0f;
-      if (t < 0) t = 0; if (t > 1) t = 1;
-      heatTarget = 3.0f + 6.0f * t; // 3..9 over startup
-      } break;
-
-    case MODE_STABILIZING: {
-      uint8_t step = ReactorSequences::getStep(MODE_STABILIZING);
-      uint8_t total = ReactorSequences::getTotalSteps(MODE_STABILIZING);
-      float t = (total > 1) ? (float)step / (float)(total - 1) : 0.0f;
-      heatTarget = 9.0f - (9.0f - 3.0f) * t;
-      } break;
+    case MODE_ARMING:
+      // Rods at the end of the withdraw ramp: CRITICAL has no recipe and
+      // carries on from here
+      in.power = 160; in.rods = 0; in.flow = 64; in.cryo = 0;
+      break;
+
+    case MODE_STARTUP:
+      in.rods = 64; in.flow = 64; in.cryo = 0;
+      break;
+
+    case MODE_STABILIZING:
+      // Pumps to full. Out of a meltdown they are still spinning up when
+      // this starts; the runaway check waits for them (ReactorSystem).
+      in.power = 255; in.flow = 128; in.cryo = 0;
+      break;
 
     case MODE_FREEZEDOWN:
-      heatTarget = 1.0f; // near freezing
+      in.power = 128; in.rods = 128; in.flow = 64;
       break;
 
-    case MODE_SHUTDOWN: {
-      // Gradually decrease heat during shutdown
-      uint8_t step = ReactorSequences::getStep(MODE_SHUTDOWN);
-      uint8_t total = ReactorSequences::getTotalSteps(MODE_SHUTDOWN);
-      float t = (total > 0) ? (float)step / (float)total : 0.0f;
-      if (t < 0) t = 0; if (t > 1) t = 1;
-      heatTarget = 6.0f - 3.0f * t; // 6..3 over shutdown
-      } break;
+    case MODE_SHUTDOWN:
+      in.power = 128; in.flow = 64; in.cryo = 0;
+      break;
 
     case MODE_MELTDOWN:
-      heatTarget = 11.5f; // drive near max during meltdown
+      in.power = 255; in.rods = 0; in.flow = 0; in.cryo = 0;  // uncooled, rods out
       break;
 
     default:
       break;
   }
+}
+
+static void updateInputsForMode(Mode mode) {
+  if (mode != cachedMode) {
+    // Modes without a recipe keep the previous mode's inputs
+    buildInputsForMode(mode, base);
+    rampIdx = -1;
+    for (uint8_t i = 0; i < RAMP_COUNT; ++i) {
+      if (pgm_read_byte(&RAMPS[i].mode) == mode) rampIdx = i;
+    }
+    cachedMode = mode;
+  }
+
+  ReactorThermal::Inputs in = base;
+  if (rampIdx >= 0) {
+    const Ramp* r = &RAMPS[rampIdx];
+    uint8_t from = pgm_read_byte(&r->from);
+    uint8_t to   = pgm_read_byte(&r->to);
+    uint8_t k = curveAt(pgm_read_byte(&r->curve),
+                        millis() - ReactorStateMachine::modeEnteredAt,
+                        ReactorStateMachine::timeoutMs(mode));
+    int32_t span = ((int32_t)to - from) * k;
+    channelOf(in, pgm_read_byte(&r->channel)) = from + (span + (span < 0 ? -127 : 127)) / 255;
+  }
+
+  // Incidents and the cryo secret act on top
+  ReactorEvents::shapeCoreInputs(in);
+  if (ReactorSecrets::isCryoLocked()) in.cryo = 255;
+
+  ReactorThermal::setInputs(in);
+}
 
-  ReactorHeat::setTarget(heatTarget);
+void begin() {
+  cachedMode = 0xFF;
+  rampIdx = -1;
 }
 
 void tick(Mode mode) {
-  updateTargetForMode(mode);
+  updateInputsForMode(mode);
   ReactorHeat::tick(mode);
 }
 
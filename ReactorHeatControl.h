@@ -3,6 +3,9 @@
 #include "ReactorTypes.h"
 
 namespace ReactorHeatControl {
+  // Forget the cached mode so the next tick rebuilds the inputs
+  void begin();
+
   // Update heat target and tick heat behavior for the current mode.
   void tick(Mode mode);
 }
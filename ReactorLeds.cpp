@@ -0,0 +1,95 @@
+#include "ReactorLeds.h"
+
+namespace ReactorLeds {
+
+namespace {
+  const uint8_t LED_PINS[LED_COUNT] = {
+    13, 12, 11, 9,                              // meltdown, stable, startup, freezedown
+    22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33  // heat bar
+  };
+  const bool HEAT_ACTIVE_HIGH = true;
+
+  const uint16_t STATUS_MASK = (1u << LED_HEAT_0) - 1;
+  const uint16_t HEAT_MASK   = (uint16_t)~STATUS_MASK;
+
+  // Per-owner claimed LEDs and the values they want
+  uint16_t claimMask[OWNER_COUNT];
+  uint16_t wantMask[OWNER_COUNT];
+
+  // Logical (on = 1) state last written to the pins
+  uint16_t shadow = 0;
+
+  inline uint16_t maskOf(Led led) { return (uint16_t)1 << led; }
+
+  void writePin(uint8_t idx, bool on) {
+    if (idx >= LED_HEAT_0 && !HEAT_ACTIVE_HIGH) on = !on;
+    digitalWrite(LED_PINS[idx], on ? HIGH : LOW);
+  }
+
+  uint16_t resolve() {
+    uint16_t out = 0;
+    uint16_t taken = 0;
+    for (uint8_t o = OWNER_COUNT; o-- > 0; ) {
+      uint16_t mine = claimMask[o] & ~taken;
+      out   |= wantMask[o] & mine;
+      taken |= mine;
+    }
+    return out;
+  }
+}
+
+void begin() {
+  for (uint8_t o = 0; o < OWNER_COUNT; ++o) {
+    claimMask[o] = 0;
+    wantMask[o] = 0;
+  }
+  // The mode owner always holds every LED so there is a defined fallback
+  claimMask[OWNER_MODE] = STATUS_MASK | HEAT_MASK;
+
+  shadow = 0;
+  for (uint8_t i = 0; i < LED_COUNT; ++i) {
+    pinMode(LED_PINS[i], OUTPUT);
+    writePin(i, false);
+  }
+}
+
+void set(Owner owner, Led led, bool on) {
+  claimMask[owner] |= maskOf(led);
+  if (on) wantMask[owner] |=  maskOf(led);
+  else    wantMask[owner] &= ~maskOf(led);
+}
+
+void release(Owner owner, Led led) {
+  if (owner == OWNER_MODE) return;
+  claimMask[owner] &= ~maskOf(led);
+}
+
+void statusOff() {
+  wantMask[OWNER_MODE] &= ~STATUS_MASK;
+}
+
+void statusOnly(Led led) {
+  statusOff();
+  set(OWNER_MODE, led, true);
+}
+
+bool isOn(Led led) {
+  return (resolve() & maskOf(led)) != 0;
+}
+
+bool wants(Owner owner, Led led) {
+  return (claimMask[owner] & wantMask[owner] & maskOf(led)) != 0;
+}
+
+void commit() {
+  uint16_t want = resolve();
+  uint16_t diff = want ^ shadow;
+  if (!diff) return;
+
+  for (uint8_t i = 0; i < LED_COUNT; ++i) {
+    if (diff & ((uint16_t)1 << i)) writePin(i, (want >> i) & 1);
+  }
+  shadow = want;
+}
+
+} // namespace ReactorLeds
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorLeds {
+
+// Indicator LEDs: the four status lamps followed by the 12-segment heat bar
+enum Led : uint8_t {
+  LED_MELTDOWN,
+  LED_STABLE,
+  LED_STARTUP,
+  LED_FREEZEDOWN,
+  LED_HEAT_0,                 // heat bar segment 0; segment i is LED_HEAT_0 + i
+  LED_COUNT = LED_HEAT_0 + 12
+};
+
+// Owners in ascending priority; a higher owner's claim on an LED wins
+enum Owner : uint8_t {
+  OWNER_MODE,   // state machine, sequences, meltdown/chaos/dark, heat bar
+  OWNER_EVENT,  // active incident blinking the meltdown LED
+  OWNER_COUNT
+};
+
+void begin();
+
+// Desired state only; nothing reaches the pins until commit()
+void set(Owner owner, Led led, bool on);
+void release(Owner owner, Led led);
+
+// Mode owner helpers for the four status lamps
+void statusOff();
+void statusOnly(Led led);
+
+// Resolved (highest-priority) desired state of one LED
+bool isOn(Led led);
+
+// One owner's own claim on an LED, regardless of priority
+bool wants(Owner owner, Led led);
+
+// Write only the pins whose resolved state changed since the last commit
+void commit();
+
+} // namespace ReactorLeds
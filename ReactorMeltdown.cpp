@@ -1,22 +1,17 @@
 #include "ReactorMeltdown.h"
 #include "ReactorAudio.h"
 #include "ReactorSequences.h"
-#include "ReactorStateMachine.h"
+#include "ReactorLeds.h"
 
 namespace ReactorMeltdown {
 
 // ======================= Timing Constants =======================
 const unsigned long MELTDOWN_BLINK_MS = 125;
 const unsigned int  MELTDOWN_TONE_HZ  = 1000;
-const unsigned long MELTDOWN_COUNTDOWN_MS = 10000; // 10 seconds
 
 // ======================= State Variables =======================
 unsigned long meltdownTickAt = 0;
 bool          meltdownPhase  = false;
-unsigned long meltdownStart  = 0;
-
-// ======================= Pins =======================
-const uint8_t PIN_LED_MELTDOWN = 13;
 
 // ======================= Helpers =======================
 inline void buzzerOff() { ReactorAudio::off(); }
@@ -24,14 +19,12 @@ inline void buzzerTone(unsigned int hz) { ReactorAudio::toneHz(hz); }
 
 // ======================= API =======================
 void begin() {
-  pinMode(PIN_LED_MELTDOWN, OUTPUT);
   reset();
 }
 
 void reset() {
   meltdownPhase = false;
   meltdownTickAt = 0;
-  meltdownStart = millis();
 }
 
 void tick() {
@@ -41,21 +34,14 @@ void tick() {
   if (now - meltdownTickAt >= MELTDOWN_BLINK_MS) {
     meltdownTickAt = now;
     meltdownPhase = !meltdownPhase;
-    digitalWrite(PIN_LED_MELTDOWN, meltdownPhase ? HIGH : LOW);
+    ReactorLeds::set(ReactorLeds::OWNER_MODE, ReactorLeds::LED_MELTDOWN, meltdownPhase);
     if (meltdownPhase) buzzerTone(MELTDOWN_TONE_HZ);
     else               buzzerOff();
   }
 
-  // Countdown to CHAOS
-  unsigned long elapsed = now - meltdownStart;
-  if (elapsed >= MELTDOWN_COUNTDOWN_MS) {
-    buzzerOff();
-    ReactorStateMachine::enterChaos();
-    return;
-  }
-  
-  // Note: Countdown display is handled by ReactorUI/ReactorUIFrames
-  // based on meltdownStartAt timestamp, not by this module
+  // Note: the countdown to CHAOS is the MELTDOWN timeout in the
+  // ReactorStateMachine transition table; the display is handled by
+  // ReactorUI/ReactorUIFrames based on the meltdownStartAt timestamp
 }
 
 } // namespace ReactorMeltdown
@@ -0,0 +1,148 @@
+#include "ReactorMirror.h"
+#include "ReactorTelemetry.h"
+#include "ReactorTunables.h"
+#include "ReactorUI.h"
+
+namespace ReactorMirror {
+
+#ifdef REACTOR_MIRROR
+namespace {
+  const uint8_t  WIDTH      = 128;
+  const uint8_t  PAGES      = 8;
+  const uint8_t  HEADER     = 4;     // 'P' pass page col
+  const uint8_t  RUN_MAX    = 128;
+  const uint8_t  KEY_PASSES = 64;    // periodic resync in case the host lost a packet
+
+  // What the host holds; a column is dirty while it differs from the buffer
+  uint8_t shadow[WIDTH * PAGES];
+
+  bool          enabled = false;
+  bool          needClear = false;
+  bool          passActive = false;
+  unsigned long passAt = 0;
+  uint8_t       pass = 0;
+  uint8_t       page = 0;
+  uint8_t       col = 0;
+
+  // Pack the XOR delta of one page from column 'from' into out (at most room
+  // bytes). Returns the output length; cols gets the columns covered.
+  uint8_t encode(const uint8_t* cur, const uint8_t* old, uint8_t from,
+                 uint8_t* out, uint8_t room, uint8_t& cols) {
+    uint8_t o = 0;
+    uint8_t c = from;
+    while (c < WIDTH && room - o >= 2) {
+      uint8_t d = cur[c] ^ old[c];
+      uint8_t run = 1;
+      while (c + run < WIDTH && run < RUN_MAX && (cur[c + run] ^ old[c + run]) == d) ++run;
+      if (run >= 3) {
+        out[o++] = 0x7F + run;
+        out[o++] = d;
+        c += run;
+        continue;
+      }
+      // Literal bytes until the next run of three or the room runs out
+      uint8_t head = o++;
+      uint8_t lit = 0;
+      while (c < WIDTH && lit < RUN_MAX && o < room) {
+        d = cur[c] ^ old[c];
+        if (c + 2 < WIDTH && (cur[c + 1] ^ old[c + 1]) == d && (cur[c + 2] ^ old[c + 2]) == d) break;
+        out[o++] = d;
+        ++c;
+        ++lit;
+      }
+      if (!lit) { --o; break; }
+      out[head] = lit - 1;
+    }
+    cols = c - from;
+    return o;
+  }
+
+  bool sendMarker(uint8_t type) {
+    uint8_t p[2] = { type, pass };
+    return ReactorTelemetry::send(p, sizeof(p));
+  }
+
+  // Move (page, col) to the next column the host does not have yet
+  bool findDirty(const uint8_t* buf) {
+    for (; page < PAGES; ++page, col = 0) {
+      uint16_t base = (uint16_t)page * WIDTH;
+      for (; col < WIDTH; ++col) {
+        if (buf[base + col] != shadow[base + col]) return true;
+      }
+    }
+    return false;
+  }
+}
+
+void resync() {
+  needClear = true;
+}
+
+bool active() {
+  return ReactorTunables::get(ReactorTunables::TN_MIRROR_MS) != 0;
+}
+
+void tick() {
+  uint16_t period = ReactorTunables::get(ReactorTunables::TN_MIRROR_MS);
+  if (!period) {
+    enabled = false;
+    passActive = false;
+    return;
+  }
+  if (!enabled) {
+    enabled = true;
+    needClear = true;
+  }
+
+  unsigned long now = millis();
+  if (!passActive) {
+    if (now - passAt < period) return;
+    passAt = now;
+    passActive = true;
+    page = 0;
+    col = 0;
+    if (++pass % KEY_PASSES == 0) needClear = true;
+  }
+
+  if (needClear) {
+    if (!sendMarker('K')) return;
+    memset(shadow, 0, sizeof(shadow));
+    needClear = false;
+    page = 0;
+    col = 0;
+  }
+
+  const uint8_t* buf = ReactorUI::display.getBuffer();
+  if (!findDirty(buf)) {
+    if (sendMarker('E')) passActive = false;
+    return;
+  }
+
+  // One chunk per loop, sized to what the TX buffer takes without blocking
+  int room = Serial.availableForWrite() - ReactorTelemetry::headroom();
+  if (room > ReactorTelemetry::wireLength(ReactorTelemetry::MAX_PAYLOAD)) {
+    room = ReactorTelemetry::wireLength(ReactorTelemetry::MAX_PAYLOAD);
+  }
+  room -= ReactorTelemetry::wireLength(HEADER);
+  if (room < 2) return;
+
+  uint8_t payload[ReactorTelemetry::MAX_PAYLOAD];
+  uint16_t base = (uint16_t)page * WIDTH;
+  uint8_t cols;
+  uint8_t len = encode(buf + base, shadow + base, col, payload + HEADER, room, cols);
+  payload[0] = 'P';
+  payload[1] = pass;
+  payload[2] = page;
+  payload[3] = col;
+  if (!ReactorTelemetry::send(payload, HEADER + len)) return;
+
+  memcpy(shadow + base + col, buf + base + col, cols);
+  col += cols;
+}
+#else
+void resync() {}
+void tick() {}
+bool active() { return false; }
+#endif
+
+} // namespace ReactorMirror
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorMirror {
+
+// Streams the framebuffer to a host as XOR-delta pages while mirror_ms
+// (ReactorTunables; 0 = off) is set. Every mirror_ms a pass walks the 8
+// pages and sends what changed since the last pass, one chunk per loop and
+// only into free TX space, so it never waits on Serial and never holds up a
+// repaint. Packets use the ReactorTelemetry framing (COBS + CRC-16);
+// tools/mirror_view.py turns a capture into PBM frames or a GIF.
+// Only compiled in with -DREACTOR_MIRROR (the shadow copy is 1 KB of SRAM);
+// otherwise tick() and resync() do nothing and mirror_ms is ignored.
+//
+// Payloads (MIRROR_VERSION 1):
+//   'K' pass                   clear the image (keyframe follows)
+//   'P' pass page col data...  XOR runs for page from column col:
+//                              n < 0x80: n+1 literal bytes follow
+//                              n >= 0x80: next byte repeats n-0x7F times
+//   'E' pass                   pass complete; the image is a frame
+const uint8_t MIRROR_VERSION = 1;
+
+// Call once per loop, after the frame is drawn
+void tick();
+
+// Clear the host image and resend everything on the next pass
+void resync();
+
+// Built in and mirror_ms is set
+bool active();
+
+} // namespace ReactorMirror
@@ -0,0 +1,65 @@
+#include "ReactorRandom.h"
+
+namespace ReactorRandom {
+
+namespace {
+  uint32_t state = 0x2545F491UL;
+}
+
+void seed(uint32_t s) {
+  // Spread small seeds (analogRead noise, 16-bit replay seeds) over all bits
+  state = s ^ 0x9E3779B9UL;
+  if (!state) state = 0x2545F491UL;
+}
+
+uint32_t save() {
+  return state;
+}
+
+void restore(uint32_t s) {
+  if (s) state = s;
+}
+
+uint32_t next() {
+  uint32_t x = state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  state = x;
+  return x;
+}
+
+uint16_t below(uint16_t n) {
+  // High half of the state times n; a 16x16 multiply on AVR
+  return (uint16_t)(((uint32_t)(uint16_t)(next() >> 16) * n) >> 16);
+}
+
+int16_t range(int16_t lo, int16_t hi) {
+  if (hi <= lo) return lo;
+  return lo + (int16_t)below((uint16_t)(hi - lo));
+}
+
+bool coin() {
+  return next() & 0x80000000UL;
+}
+
+void fillBytes(uint8_t* buf, uint16_t len) {
+  while (len >= 4) {
+    uint32_t x = next();
+    buf[0] = (uint8_t)x;
+    buf[1] = (uint8_t)(x >> 8);
+    buf[2] = (uint8_t)(x >> 16);
+    buf[3] = (uint8_t)(x >> 24);
+    buf += 4;
+    len -= 4;
+  }
+  if (len) {
+    uint32_t x = next();
+    while (len--) {
+      *buf++ = (uint8_t)x;
+      x >>= 8;
+    }
+  }
+}
+
+} // namespace ReactorRandom
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorRandom {
+
+// xorshift32 generator shared by every effect, event and fuzz path. One
+// explicit seed reproduces a whole session, so a replayed recording draws
+// the same numbers in the same order. Cheaper than Arduino random(), which
+// runs a 32-bit multiply plus a 32-bit modulus on every call.
+
+// Any seed is accepted (0 is remapped; xorshift must never hold zero)
+void seed(uint32_t s);
+
+// Generator state, to run something on a fixed seed and then carry on with
+// the session's sequence as if it had never happened (ReactorBench)
+uint32_t save();
+void restore(uint32_t s);
+
+uint32_t next();
+
+// Uniform in 0..n-1 by multiply-shift (no division); 0 when n == 0
+uint16_t below(uint16_t n);
+
+// Uniform in lo..hi-1, matching random(lo, hi); lo when hi <= lo
+int16_t range(int16_t lo, int16_t hi);
+
+// Coin flip
+bool coin();
+
+// Fill buf with len random bytes, four per generator step
+void fillBytes(uint8_t* buf, uint16_t len);
+
+} // namespace ReactorRandom
@@ -0,0 +1,141 @@
+#include "ReactorReplay.h"
+#include "ReactorButtons.h"
+#include "ReactorStateMachine.h"
+#include "ReactorAudio.h"
+#include "ReactorHeat.h"
+#include "ReactorHeatControl.h"
+#include "ReactorEvents.h"
+#include "ReactorSecrets.h"
+#include "ReactorSequences.h"
+#include "ReactorMeltdown.h"
+#include "ReactorChaos.h"
+#include "ReactorDark.h"
+#include "ReactorAnimations.h"
+#include "ReactorUI.h"
+#include "ReactorDiag.h"
+#include "ReactorReplaySession.h"
+#include "ReactorRandom.h"
+
+namespace ReactorReplay {
+
+namespace {
+  // Recorded session (first edges only; recording stops when full)
+  const uint8_t LOG_SIZE = 128;
+  Edge          edgeLog[LOG_SIZE];
+  uint8_t       logCount = 0;
+  unsigned long lastEdgeAt = 0;
+  uint16_t      g_seed = 0;
+
+  // Playback cursor into REPLAY_EDGES
+  bool          playing = false;
+  uint8_t       playIdx = 0;
+  unsigned long playNextAt = 0;
+
+  void applySeed(uint16_t s) {
+    g_seed = s;
+    ReactorRandom::seed(s);
+  }
+
+  void restartLog() {
+    logCount = 0;
+    lastEdgeAt = millis();
+  }
+
+  // Everything a live session leaves behind that changes what an edge does.
+  // Trace, stats and tunables are records or settings, not session state.
+  void resetSession() {
+    ReactorButtons::begin();
+    ReactorAudio::unmute();
+    ReactorAudio::off();
+    ReactorHeat::begin();
+    ReactorHeatControl::begin();
+    ReactorEvents::begin();
+    ReactorSecrets::begin();
+    ReactorSequences::begin();
+    ReactorMeltdown::begin();
+    ReactorChaos::begin();
+    ReactorDark::begin();
+    ReactorAnimations::resetParticles();
+    ReactorUI::hideTrend();
+    ReactorDiag::hideScreen();
+  }
+
+  void cueNext() {
+    uint16_t dt = pgm_read_word(&REPLAY_EDGES[playIdx].dtMs);
+    char code = (char)pgm_read_byte(&REPLAY_EDGES[playIdx].code);
+    if (!code) { playing = false; return; }
+    playNextAt += dt;
+  }
+}
+
+void begin(uint16_t liveSeed) {
+#ifdef REACTOR_REPLAY
+  (void)liveSeed;
+  startPlayback();
+#else
+  applySeed(liveSeed);
+  restartLog();
+#endif
+}
+
+void recordEdge(char code) {
+  if (logCount >= LOG_SIZE) return;
+  unsigned long now = millis();
+  unsigned long dt = now - lastEdgeAt;
+  lastEdgeAt = now;
+  edgeLog[logCount].dtMs = dt > 0xFFFF ? 0xFFFF : (uint16_t)dt;
+  edgeLog[logCount].code = code;
+  ++logCount;
+}
+
+void startPlayback() {
+  resetSession();
+  ReactorStateMachine::enterStable();
+  applySeed(REPLAY_SEED);
+  restartLog();
+  playing = true;
+  playIdx = 0;
+  playNextAt = lastEdgeAt;
+  cueNext();
+}
+
+bool isPlaying() {
+  return playing;
+}
+
+void tick() {
+  if (!playing) return;
+  unsigned long now = millis();
+  // Inject every edge that is due; the loop's own latency is the only jitter
+  while (playing && (long)(now - playNextAt) >= 0) {
+    char code = (char)pgm_read_byte(&REPLAY_EDGES[playIdx].code);
+    bool release = code >= 'a';
+    ReactorButtons::hold(release ? (char)(code & ~0x20) : code, !release);
+    ++playIdx;
+    cueNext();
+  }
+}
+
+uint16_t seed() {
+  return g_seed;
+}
+
+void dumpSession(Print& out) {
+  out.println(F("#pragma once"));
+  out.println();
+  out.print(F("const uint16_t REPLAY_SEED = "));
+  out.print(g_seed);
+  out.println(';');
+  out.println(F("const ReactorReplay::Edge REPLAY_EDGES[] PROGMEM = {"));
+  for (uint8_t i = 0; i < logCount; ++i) {
+    out.print(F("  { "));
+    out.print(edgeLog[i].dtMs);
+    out.print(F(", '"));
+    out.print(edgeLog[i].code);
+    out.println(F("' },"));
+  }
+  out.println(F("  { 0, 0 }"));
+  out.println(F("};"));
+}
+
+} // namespace ReactorReplay
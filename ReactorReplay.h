@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorReplay {
+
+// One button edge: delay since the previous edge (or session start) and the
+// button code, upper case for a press ('O','S','U','F','D','E','A') and lower
+// case for the release, so held buttons (ACK chords) play back as held.
+// A {0, 0} entry ends a session.
+struct Edge {
+  uint16_t dtMs;
+  char     code;
+};
+
+// Seed the RNG and start the session clock. With -DREACTOR_REPLAY the
+// compiled-in session's seed replaces liveSeed and playback starts at once.
+void begin(uint16_t liveSeed);
+
+// Called by ReactorButtons for every debounced or injected press and release
+void recordEdge(char code);
+
+// Call once per loop (before ReactorButtons::update) to inject due edges
+void tick();
+
+// Reset every session module (core, incidents, secrets, mute, trend and
+// diagnostics screens, debouncers), restart from STABLE with the compiled-in
+// session's seed and play it back
+void startPlayback();
+bool isPlaying();
+
+uint16_t seed();
+
+// Print the recorded session in ReactorReplaySession.h format
+void dumpSession(Print& out);
+
+} // namespace ReactorReplay
@@ -0,0 +1,8 @@
+#pragma once
+
+// Compiled-in session for ReactorReplay. Replace this file with the output
+// of the console 'session' command to replay a recorded operator session.
+const uint16_t REPLAY_SEED = 0;
+const ReactorReplay::Edge REPLAY_EDGES[] PROGMEM = {
+  { 0, 0 }
+};
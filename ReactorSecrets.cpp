@@ -2,14 +2,15 @@
 #include "ReactorUI.h"
 #include "ReactorAudio.h"
 #include "ReactorHeat.h"
+#include "ReactorTrace.h"
+#include "ReactorStats.h"
+#include "ReactorSecretsDfa.h"
 
 namespace ReactorSecrets {
 
 namespace {
-  // Sequence capture
-  const uint8_t SEQ_MAX = 10;
-  char seqBuffer[SEQ_MAX];
-  uint8_t seqLength = 0;
+  // Sequence capture: one matcher state (see ReactorSecretsDfa.h)
+  uint8_t seqState = 0;
   unsigned long seqLastInput = 0;
   const unsigned long SEQ_TIMEOUT_MS = 3000; // 3s between presses
 
@@ -29,23 +30,6 @@ bool isCryoLocked() {
   return g_cryoUntil && millis() < g_cryoUntil;
 }
 
-static uint8_t patternLenNoSpaces(const char* p) {
-  uint8_t n = 0;
-  for (uint8_t i=0; p[i]; ++i) if (p[i] != ' ') n++;
-  return n;
-}
-
-static bool matchesExact(const char* pattern) {
-  uint8_t want = patternLenNoSpaces(pattern);
-  if (seqLength != want) return false;
-  uint8_t j = 0;
-  for (uint8_t i=0; pattern[i]; ++i) {
-    if (pattern[i] == ' ') continue;
-    if (seqBuffer[j++] != pattern[i]) return false;
-  }
-  return true;
-}
-
 void secretToneSweep() {
   if (isMuted()) return;
   for (int f = 420; f < 1800; f += 90) {
@@ -58,6 +42,7 @@ void secretToneSweep() {
 
 void enterGodMode() {
   g_godMode = true;
+  ReactorTrace::record(ReactorTrace::TR_SECRET, 'G');
   secretToneSweep();
   ReactorUI::display.clearDisplay();
   ReactorUI::display.setTextColor(SSD1306_WHITE);
@@ -68,7 +53,7 @@ void enterGodMode() {
   int16_t y = ((int16_t)ReactorUI::display.height() - (int16_t)h) / 2;
   ReactorUI::display.setCursor(x, y);
   ReactorUI::display.println("OVERRIDE PROTOCOL");
-  ReactorUI::display.display();
+  ReactorUI::flush();
   delay(650);
   
   ReactorUI::display.clearDisplay();
@@ -78,11 +63,12 @@ void enterGodMode() {
   y = ((int16_t)ReactorUI::display.height() - (int16_t)h) / 2;
   ReactorUI::display.setCursor(x, y);
   ReactorUI::display.println("GOD MODE");
-  ReactorUI::display.display();
+  ReactorUI::flush();
   delay(700);
 }
 
 void enterCryoLockdown() {
+  ReactorTrace::record(ReactorTrace::TR_SECRET, 'Y');
   secretToneSweep();
   ReactorUI::display.clearDisplay();
   ReactorUI::display.setTextColor(SSD1306_WHITE);
@@ -93,70 +79,63 @@ void enterCryoLockdown() {
   int16_t y = ((int16_t)ReactorUI::display.height() - (int16_t)h) / 2;
   ReactorUI::display.setCursor(x, y);
   ReactorUI::display.println("CRYO LOCKDOWN");
-  ReactorUI::display.display();
+  ReactorUI::flush();
   delay(700);
   
-  float cooled = max(ReactorHeat::getLevel() - 3.0f, 0.0f);
-  ReactorHeat::setLevel(cooled);
+  uint16_t level = ReactorHeat::levelQ8();
+  ReactorHeat::setLevelQ8(level > (3 << 8) ? level - (3 << 8) : 0);
   g_cryoUntil = millis() + CRYO_LOCK_MS;
 }
 
-void checkSecretSequence() {
-  if (millis() - seqLastInput > SEQ_TIMEOUT_MS) {
-    seqLength = 0;
-    return;
-  }
-  
-  // S - (S)tabilize  (Green Button)
-  // O - (O)verride   (Red Button)
-  // U - Start(U)p    (Yellow Button)
-  // F - (F)reezedown (Blue Button)
-
-  const char* GOD_SEQ   = "O S F U O";
-  const char* CHAOS_SEQ = "U U F S O F";
-  const char* CRYO_SEQ  = "F F O S";
-
-  uint8_t n = seqLength;
-  if (n == patternLenNoSpaces(GOD_SEQ) && matchesExact(GOD_SEQ)) {
-    seqLength = 0;
-    enterGodMode();
-    return;
-  }
-  if (n == patternLenNoSpaces(CHAOS_SEQ) && matchesExact(CHAOS_SEQ)) {
-    seqLength = 0;
-    // Chaos entry will be handled by ReactorSystem
-    return;
-  }
-  if (n == patternLenNoSpaces(CRYO_SEQ) && matchesExact(CRYO_SEQ)) {
-    seqLength = 0;
-    enterCryoLockdown();
-    return;
+// S - (S)tabilize  (Green Button)
+// O - (O)verride   (Red Button)
+// U - Start(U)p    (Yellow Button)
+// F - (F)reezedown (Blue Button)
+static void fire(uint8_t secret) {
+  ReactorStats::bump(ReactorStats::ST_SECRETS);
+  switch (secret) {
+    case ReactorSecretsDfa::SECRET_GOD:
+      enterGodMode();
+      break;
+    case ReactorSecretsDfa::SECRET_CHAOS:
+      ReactorTrace::record(ReactorTrace::TR_SECRET, 'C');
+      // Chaos entry will be handled by ReactorSystem
+      break;
+    case ReactorSecretsDfa::SECRET_CRYO:
+      enterCryoLockdown();
+      break;
   }
+}
 
-  uint8_t maxPat = max(patternLenNoSpaces(GOD_SEQ), max(patternLenNoSpaces(CHAOS_SEQ), patternLenNoSpaces(CRYO_SEQ)));
-  if (seqLength > maxPat) seqLength = 0;
+void setGodMode(bool on) {
+  if (on) enterGodMode();
+  else    g_godMode = false;
 }
 
 void begin() {
-  seqLength = 0;
+  seqState = 0;
   seqLastInput = 0;
   g_godMode = false;
   g_cryoUntil = 0;
 }
 
+// One flash lookup per press; a secret matches wherever it ends in the stream
 void captureInput(char code) {
-  if (seqLength < SEQ_MAX) {
-    seqBuffer[seqLength++] = code;
-    seqLastInput = millis();
-    checkSecretSequence();
-  } else {
-    seqLength = 0;
+  uint8_t sym = ReactorSecretsDfa::symbolOf(code);
+  if (sym >= ReactorSecretsDfa::SYMBOL_COUNT) return;
+  seqState = pgm_read_byte(&ReactorSecretsDfa::NEXT[seqState][sym]);
+  seqLastInput = millis();
+
+  uint8_t secret = pgm_read_byte(&ReactorSecretsDfa::MATCH[seqState]);
+  if (secret != ReactorSecretsDfa::SECRET_NONE) {
+    seqState = 0;
+    fire(secret);
   }
 }
 
 void tick() {
-  if (seqLength > 0 && (millis() - seqLastInput > SEQ_TIMEOUT_MS)) {
-    seqLength = 0; // timeout-based reset
+  if (seqState && (millis() - seqLastInput > SEQ_TIMEOUT_MS)) {
+    seqState = 0; // timeout-based reset
   }
   if (g_cryoUntil && millis() >= g_cryoUntil) {
     g_cryoUntil = 0;
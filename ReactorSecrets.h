@@ -7,6 +7,7 @@ namespace ReactorSecrets {
 void begin();
 void captureInput(char code);
 bool isGodMode();
+void setGodMode(bool on);   // on plays the god-mode reveal, as the sequence does
 bool isCryoLocked();
 void tick();
 
@@ -0,0 +1,55 @@
+#pragma once
+
+// Generated by tools/gen_secrets_dfa.py -- do not edit; rerun the script.
+// Secret sequences: SECRET_GOD "OSFUO", SECRET_CHAOS "UUFSOF", SECRET_CRYO "FFOS"
+
+namespace ReactorSecretsDfa {
+
+enum Secret : uint8_t {
+  SECRET_NONE,
+  SECRET_GOD,
+  SECRET_CHAOS,
+  SECRET_CRYO,
+};
+
+const uint8_t SYMBOL_COUNT = 6;   // O S U F D E
+const uint8_t STATE_COUNT  = 16;
+
+// Alphabet index of a button code, or SYMBOL_COUNT if it is not in any secret
+inline uint8_t symbolOf(char code) {
+  switch (code) {
+    case 'O': return 0;
+    case 'S': return 1;
+    case 'U': return 2;
+    case 'F': return 3;
+    case 'D': return 4;
+    case 'E': return 5;
+    default:  return SYMBOL_COUNT;
+  }
+}
+
+const uint8_t NEXT[STATE_COUNT][SYMBOL_COUNT] PROGMEM = {
+  {  1,  0,  6, 12,  0,  0 },  // 0
+  {  1,  2,  6, 12,  0,  0 },  // 1
+  {  1,  0,  6,  3,  0,  0 },  // 2
+  {  1,  0,  4, 13,  0,  0 },  // 3
+  {  5,  0,  7, 12,  0,  0 },  // 4
+  {  1,  2,  6, 12,  0,  0 },  // 5
+  {  1,  0,  7, 12,  0,  0 },  // 6
+  {  1,  0,  7,  8,  0,  0 },  // 7
+  {  1,  9,  6, 13,  0,  0 },  // 8
+  { 10,  0,  6, 12,  0,  0 },  // 9
+  {  1,  2,  6, 11,  0,  0 },  // 10
+  {  1,  0,  6, 13,  0,  0 },  // 11
+  {  1,  0,  6, 13,  0,  0 },  // 12
+  { 14,  0,  6, 13,  0,  0 },  // 13
+  {  1, 15,  6, 12,  0,  0 },  // 14
+  {  1,  0,  6,  3,  0,  0 },  // 15
+};
+
+// Secret completed on entering each state
+const uint8_t MATCH[STATE_COUNT] PROGMEM = {
+  0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 2, 0, 0, 0, 3
+};
+
+} // namespace ReactorSecretsDfa
@@ -3,6 +3,8 @@
 #include "ReactorAudio.h"
 #include "ReactorUI.h"
 #include "ReactorHeat.h"
+#include "ReactorLeds.h"
+#include "ReactorTunables.h"
 #include <math.h>
 
 namespace ReactorSequences {
@@ -23,8 +25,9 @@ void drawStartupStep();
 void drawShutdownStep();
 
 // ======================= Timing Constants =======================
+// Step periods and mode windows are in ReactorTunables
+
 // Arming (3-2-1)
-const unsigned long ARM_STEP_MS   = 500;
 const uint8_t       ARM_BLINKS    = 5;
 const unsigned int  ARM_CHIRP_HZ  = 1600;
 
@@ -34,7 +37,6 @@ const int           CRITICAL_ALARM_LOW_HZ    = 1200;
 const int           CRITICAL_ALARM_HIGH_HZ   = 1800;
 
 // Freezedown Sequence
-const unsigned long FREEZE_STEP_MS        = 1200;
 const uint8_t       FREEZE_TOTAL_STEPS    = 5;
 const unsigned long FREEZE_LED_PERIOD_MS  = 1200;
 
@@ -44,7 +46,6 @@ const int           FREEZE_ALARM_HIGH_HZ   = 650;
 const int           FREEZE_ALARM_LOW_HZ    = 350;
 
 // Stabilization sequence
-const unsigned long STAB_STEP_MS       = 1000;
 const uint8_t       STAB_TOTAL_STEPS   = 5;
 const unsigned long STAB_LED_PERIOD_MS = 1000;
 
@@ -54,14 +55,12 @@ const int           STAB_ALARM_LOW_HZ    = 800;
 const int           STAB_ALARM_HIGH_HZ   = 1000;
 
 // Startup sequence (multi-step + rising pitch, then auto -> Stabilizing)
-const unsigned long STARTUP_STEP_MS       = 2000;
 const uint8_t       STARTUP_TOTAL_STEPS   = 5;
 const unsigned long STARTUP_LED_PERIOD_MS = 400;
 const int           STARTUP_F0_HZ         = 300;
 const int           STARTUP_F1_HZ         = 1600;
 
 // Shutdown sequence (multi-step + falling pitch, then auto -> Stable)
-const unsigned long SHUTDOWN_STEP_MS       = 2000;
 const uint8_t       SHUTDOWN_TOTAL_STEPS   = 5;
 const unsigned long SHUTDOWN_LED_PERIOD_MS = 800;
 const int           SHUTDOWN_F0_HZ         = 1400;
@@ -145,28 +144,20 @@ unsigned long shutdownStepAt   = 0;
 unsigned long shutdownStart    = 0;
 int           lastShownShutdownStep = -1;
 
-// Pin configuration (from ReactorSystem)
-const uint8_t PIN_LED_MELTDOWN      = 13;
-const uint8_t PIN_LED_STABLE        = 12;
-const uint8_t PIN_LED_STARTUP       = 11;
-const uint8_t PIN_LED_FREEZEDOWN    = 9;
-
 // ======================= Helpers =======================
 inline bool isMuted() { return ReactorAudio::isMuted(); }
 inline void buzzerOff() { ReactorAudio::off(); }
 inline void buzzerTone(unsigned int hz) { ReactorAudio::toneHz(hz); }
+inline void ledSet(ReactorLeds::Led led, bool on) { ReactorLeds::set(ReactorLeds::OWNER_MODE, led, on); }
 
-float currentHeatPercent() {
-  uint8_t level = ReactorHeat::getLevel();
-  return (float)level / 12.0f * 100.0f;
+// Truncated to whole levels, as the sequence screens have always shown it
+uint8_t currentHeatPercent() {
+  uint8_t level = ReactorHeat::levelQ8() >> 8;
+  return (uint16_t)level * 100 / 12;
 }
 
 // ======================= API =======================
 void begin() {
-  pinMode(PIN_LED_MELTDOWN,     OUTPUT);
-  pinMode(PIN_LED_STABLE,       OUTPUT);
-  pinMode(PIN_LED_STARTUP,      OUTPUT);
-  pinMode(PIN_LED_FREEZEDOWN,   OUTPUT);
   reset();
 }
 
@@ -276,12 +267,12 @@ void finishFreezedownToStable() {
 
 // ======================= Internal Tick Functions (file scope) =======================
 void tickArming(unsigned long now) {
-  if (now - armTickAt < ARM_STEP_MS) return;
+  if (now - armTickAt < ReactorTunables::get(ReactorTunables::TN_ARM_STEP_MS)) return;
   armTickAt = now;
 
   ++armStep;
   bool onPhase = (armStep % 2) == 1;
-  digitalWrite(PIN_LED_MELTDOWN, onPhase ? HIGH : LOW);
+  ledSet(ReactorLeds::LED_MELTDOWN, onPhase);
   if (onPhase) buzzerTone(ARM_CHIRP_HZ);
   else         buzzerOff();
 
@@ -302,7 +293,7 @@ void tickCritical(unsigned long now) {
   
   // Rapid LED flashing
   bool ledOn = (now / 150) % 2 == 0;
-  digitalWrite(PIN_LED_MELTDOWN, ledOn ? HIGH : LOW);
+  ledSet(ReactorLeds::LED_MELTDOWN, ledOn);
 }
 
 void tickStabilizing(unsigned long now) {
@@ -310,7 +301,7 @@ void tickStabilizing(unsigned long now) {
   if (now - stabLedAt >= (STAB_LED_PERIOD_MS / 2)) {
     stabLedAt = now;
     stabLedOn = !stabLedOn;
-    digitalWrite(PIN_LED_STABLE, stabLedOn ? HIGH : LOW);
+    ledSet(ReactorLeds::LED_STABLE, stabLedOn);
   }
 
   // Alternate the alarm tone while stabilizing (urgent "waah-waah")
@@ -321,7 +312,7 @@ void tickStabilizing(unsigned long now) {
   }
 
   // Advance progress steps
-  if (now - stabStepAt >= STAB_STEP_MS) {
+  if (now - stabStepAt >= ReactorTunables::get(ReactorTunables::TN_STAB_STEP_MS)) {
     stabStepAt = now;
     if (stabStep < STAB_TOTAL_STEPS - 1) {
       ++stabStep;
@@ -333,7 +324,7 @@ void tickStabilizing(unsigned long now) {
 
 void tickStartup(unsigned long now) {
   unsigned long elapsedSeq = now - startupStart;
-  unsigned long totalStartupMs = (unsigned long)STARTUP_TOTAL_STEPS * STARTUP_STEP_MS;
+  unsigned long totalStartupMs = (unsigned long)STARTUP_TOTAL_STEPS * ReactorTunables::get(ReactorTunables::TN_STARTUP_STEP_MS);
   
   if (elapsedSeq < totalStartupMs) {
     float t = (float)elapsedSeq / (float)totalStartupMs;
@@ -347,10 +338,10 @@ void tickStartup(unsigned long now) {
   if (now - startupBlinkAt >= STARTUP_LED_PERIOD_MS) {
     startupBlinkAt = now;
     startupLedOn = !startupLedOn;
-    digitalWrite(PIN_LED_STARTUP, startupLedOn ? HIGH : LOW);
+    ledSet(ReactorLeds::LED_STARTUP, startupLedOn);
   }
 
-  if (now - startupStepAt >= STARTUP_STEP_MS) {
+  if (now - startupStepAt >= ReactorTunables::get(ReactorTunables::TN_STARTUP_STEP_MS)) {
     startupStepAt = now;
     if (startupStep < STARTUP_TOTAL_STEPS - 1) {
       ++startupStep;
@@ -364,7 +355,7 @@ void tickFreezedown(unsigned long now) {
   if (now - freezeLedAt >= (FREEZE_LED_PERIOD_MS / 2)) {
     freezeLedAt = now;
     freezeLedOn = !freezeLedOn;
-    digitalWrite(PIN_LED_FREEZEDOWN, freezeLedOn ? HIGH : LOW);
+    ledSet(ReactorLeds::LED_FREEZEDOWN, freezeLedOn);
   }
 
   // Alternate a low cooling alarm
@@ -375,7 +366,7 @@ void tickFreezedown(unsigned long now) {
   }
 
   // Advance progress steps
-  if (now - freezeStepAt >= FREEZE_STEP_MS) {
+  if (now - freezeStepAt >= ReactorTunables::get(ReactorTunables::TN_FREEZE_STEP_MS)) {
     freezeStepAt = now;
     if (freezeStep < FREEZE_TOTAL_STEPS - 1) {
       ++freezeStep;
@@ -386,7 +377,7 @@ void tickFreezedown(unsigned long now) {
 
 void tickShutdown(unsigned long now) {
   unsigned long elapsedSeq = now - shutdownStart;
-  unsigned long totalShutdownMs = (unsigned long)SHUTDOWN_TOTAL_STEPS * SHUTDOWN_STEP_MS;
+  unsigned long totalShutdownMs = (unsigned long)SHUTDOWN_TOTAL_STEPS * ReactorTunables::get(ReactorTunables::TN_SHUTDOWN_STEP_MS);
   
   // Play falling pitch sweep during shutdown
   if (elapsedSeq < totalShutdownMs) {
@@ -399,7 +390,7 @@ void tickShutdown(unsigned long now) {
   }
 
   // Advance progress steps
-  if (now - shutdownStepAt >= SHUTDOWN_STEP_MS) {
+  if (now - shutdownStepAt >= ReactorTunables::get(ReactorTunables::TN_SHUTDOWN_STEP_MS)) {
     shutdownStepAt = now;
     if (shutdownStep < SHUTDOWN_TOTAL_STEPS - 1) {
       ++shutdownStep;
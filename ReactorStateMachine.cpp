@@ -10,16 +10,15 @@
 #include "ReactorDark.h"
 #include "ReactorUIFrames.h"
 #include "ReactorUI.h"
+#include "ReactorEvents.h"
+#include "ReactorLeds.h"
+#include "ReactorTrace.h"
+#include "ReactorStats.h"
+#include "ReactorTunables.h"
 #include <Arduino.h>
 
 namespace ReactorStateMachine {
 
-// ======================= Pins =======================
-const uint8_t PIN_LED_MELTDOWN      = 13;
-const uint8_t PIN_LED_STABLE        = 12;
-const uint8_t PIN_LED_STARTUP       = 11;
-const uint8_t PIN_LED_FREEZEDOWN    = 9;
-
 // Arming (3-2-1)
 const uint8_t ARM_BLINKS = 5;
 
@@ -34,9 +33,20 @@ unsigned long freezeStartAt = 0;
 unsigned long startupStartAt = 0;
 unsigned long shutdownStartAt = 0;
 unsigned long meltdownStartAt = 0;  // 10 second countdown
+unsigned long modeEnteredAt = 0;
+Input enteredBy = INPUT_COUNT;      // table input behind the last mode change
 
 // ======================= Helpers =======================
 inline void buzzerOff() { ReactorAudio::off(); }
+inline void ledSet(ReactorLeds::Led led, bool on) { ReactorLeds::set(ReactorLeds::OWNER_MODE, led, on); }
+
+// Switch mode and stamp the entry time used by the timeout column
+inline void setMode(Mode mode) {
+  currentMode = mode;
+  enteredBy = INPUT_COUNT;
+  modeEnteredAt = millis();
+  ReactorTrace::record(ReactorTrace::TR_MODE, mode);
+}
 
 // ======================= API =======================
 Mode getMode() {
@@ -44,11 +54,8 @@ Mode getMode() {
 }
 
 void enterStable() {
-  currentMode = MODE_STABLE;
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE,   HIGH);
-  digitalWrite(PIN_LED_STARTUP,  LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  setMode(MODE_STABLE);
+  ReactorLeds::statusOnly(ReactorLeds::LED_STABLE);
   ReactorHeat::allOff();
 
   buzzerOff();
@@ -58,26 +65,20 @@ void enterStable() {
 
 void enterArming() {
   ReactorSweep::stop();
-  currentMode = MODE_ARMING;
+  setMode(MODE_ARMING);
   ReactorSequences::reset();
-  armingStartAt = millis();  // Start 5 second countdown
+  armingStartAt = modeEnteredAt;  // Start 5 second countdown
 
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   buzzerOff();
 }
 
 void enterCritical() {
   ReactorSweep::stop();
-  currentMode = MODE_CRITICAL;
-  criticalStartAt = millis();  // Start 3 second critical warning
+  setMode(MODE_CRITICAL);
+  criticalStartAt = modeEnteredAt;  // Start 3 second critical warning
 
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_MELTDOWN, HIGH);  // Meltdown LED on during critical
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOnly(ReactorLeds::LED_MELTDOWN);  // Meltdown LED on during critical
   buzzerOff();
 }
 
@@ -91,42 +92,38 @@ void enterMeltdown() {
   }
 
   ReactorSweep::stop();
-  currentMode = MODE_MELTDOWN;
-  meltdownStartAt = millis();
+  setMode(MODE_MELTDOWN);
+  meltdownStartAt = modeEnteredAt;
+  ReactorStats::bump(ReactorStats::ST_MELTDOWNS);
   ReactorMeltdown::reset();
+  ReactorTrace::snapshotToEeprom();
 
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ledSet(ReactorLeds::LED_STABLE, false);
+  ledSet(ReactorLeds::LED_STARTUP, false);
+  ledSet(ReactorLeds::LED_FREEZEDOWN, false);
 
   ReactorUIFrames::drawCoreStatusForce(true); // initial banner
 }
 
 void enterStabilizing() {
   ReactorSweep::stop();
-  currentMode = MODE_STABILIZING;
+  setMode(MODE_STABILIZING);
   ReactorSequences::reset();
-  stabStartAt = millis();
+  stabStartAt = modeEnteredAt;
 
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   buzzerOff(); // tick will start tones (gated by mute)
   ReactorSequences::drawStabilizingStep();
 }
 
 void enterStartup() {
   ReactorSweep::stop();
-  currentMode = MODE_STARTUP;
+  setMode(MODE_STARTUP);
   ReactorSequences::reset();
-  startupStartAt = millis();
+  startupStartAt = modeEnteredAt;
 
   buzzerOff();
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   ReactorUI::display.invertDisplay(false);
 
   ReactorSequences::drawStartupStep();
@@ -134,14 +131,11 @@ void enterStartup() {
 
 void enterFreezedown() {
   ReactorSweep::stop();
-  currentMode = MODE_FREEZEDOWN;
+  setMode(MODE_FREEZEDOWN);
   ReactorSequences::reset();
-  freezeStartAt = millis();
+  freezeStartAt = modeEnteredAt;
 
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE,   LOW);
-  digitalWrite(PIN_LED_STARTUP,  LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   buzzerOff();
   ReactorUI::display.invertDisplay(false);
 
@@ -150,14 +144,11 @@ void enterFreezedown() {
 
 void enterShutdown() {
   ReactorSweep::stop();
-  currentMode = MODE_SHUTDOWN;
+  setMode(MODE_SHUTDOWN);
   ReactorSequences::reset();
-  shutdownStartAt = millis();
+  shutdownStartAt = modeEnteredAt;
 
-  digitalWrite(PIN_LED_MELTDOWN, LOW);
-  digitalWrite(PIN_LED_STABLE, LOW);
-  digitalWrite(PIN_LED_STARTUP, LOW);
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ReactorLeds::statusOff();
   buzzerOff();
   ReactorUI::display.invertDisplay(false);
 
@@ -165,19 +156,21 @@ void enterShutdown() {
 }
 
 void enterDark() {
-  currentMode = MODE_DARK;
+  setMode(MODE_DARK);
   ReactorDark::enterDarkWithSuccess();
 }
 
 void enterChaos() {
-  currentMode = MODE_CHAOS;
+  setMode(MODE_CHAOS);
   buzzerOff();
+  ReactorStats::bump(ReactorStats::ST_CHAOS);
+  ReactorTrace::snapshotToEeprom();
   ReactorChaos::reset();
 }
 
 // ---- exits ----
 void finishFreezedownToStable() {
-  digitalWrite(PIN_LED_FREEZEDOWN, LOW);
+  ledSet(ReactorLeds::LED_FREEZEDOWN, false);
   ReactorSweep::start();
   enterStable();
 }
@@ -191,4 +184,263 @@ void finishStabilizingToStable() {
   ReactorSweep::start();
 }
 
+void finishStartupToStabilizing() {
+  buzzerOff();
+  enterStabilizing();
+}
+
+void finishShutdownToDark() {
+  buzzerOff();
+  ReactorStats::bump(ReactorStats::ST_SHUTDOWNS);
+  enterDark();
+}
+
+void triggerEvent() {
+  ReactorEvents::trigger();
+}
+
+// ======================= Transition Table =======================
+// Every mode change driven by a button or a timed window is one cell of
+// TRANSITIONS[mode][input]. Cells name a guard and an action by index so the
+// whole matrix is two bytes per cell and lives in flash.
+
+enum Guard : uint8_t {
+  GUARD_ALWAYS,
+  GUARD_NO_EVENT,       // no incident currently active
+  GUARD_COUNT
+};
+
+enum Action : uint8_t {
+  ACT_NONE,
+  ACT_ARMING,
+  ACT_CRITICAL,
+  ACT_MELTDOWN,
+  ACT_STABILIZING,
+  ACT_STARTUP,
+  ACT_FREEZEDOWN,
+  ACT_SHUTDOWN,
+  ACT_CHAOS,
+  ACT_ABORT_STABILIZING,
+  ACT_FINISH_STABILIZING,
+  ACT_FINISH_STARTUP,
+  ACT_FINISH_FREEZEDOWN,
+  ACT_FINISH_SHUTDOWN,
+  ACT_TRIGGER_EVENT,
+  ACTION_COUNT
+};
+
+struct Transition {
+  uint8_t action;
+  uint8_t guard;
+};
+
+typedef void (*ActionFn)();
+typedef bool (*GuardFn)();
+
+bool guardAlways()  { return true; }
+bool guardNoEvent() { return !ReactorEvents::isActive(); }
+
+const GuardFn GUARDS[GUARD_COUNT] PROGMEM = {
+  guardAlways,
+  guardNoEvent
+};
+
+const ActionFn ACTIONS[ACTION_COUNT] PROGMEM = {
+  nullptr,
+  enterArming,
+  enterCritical,
+  enterMeltdown,
+  enterStabilizing,
+  enterStartup,
+  enterFreezedown,
+  enterShutdown,
+  enterChaos,
+  abortStabilizingToMeltdown,
+  finishStabilizingToStable,
+  finishStartupToStabilizing,
+  finishFreezedownToStable,
+  finishShutdownToDark,
+  triggerEvent
+};
+
+// Mode each action lands in (used only by the graph dump)
+const uint8_t ACTION_TARGET[ACTION_COUNT] PROGMEM = {
+  MODE_STABLE,       // ACT_NONE (unused)
+  MODE_ARMING,
+  MODE_CRITICAL,
+  MODE_MELTDOWN,
+  MODE_STABILIZING,
+  MODE_STARTUP,
+  MODE_FREEZEDOWN,
+  MODE_SHUTDOWN,
+  MODE_CHAOS,
+  MODE_MELTDOWN,
+  MODE_STABLE,
+  MODE_STABILIZING,
+  MODE_STABLE,
+  MODE_DARK,
+  MODE_STABLE        // event trigger keeps the current mode
+};
+
+// Timed window per mode: a tunable times a step count; 0 steps = no timeout
+struct ModeTimeout {
+  uint8_t tunable;  // ReactorTunables::Id
+  uint8_t steps;
+};
+
+const ModeTimeout MODE_TIMEOUTS[MODE_COUNT] PROGMEM = {
+  { 0, 0 },                                        // STABLE
+  { ReactorTunables::TN_ARM_STEP_MS,      10 },    // ARMING: 5 blinks, on + off
+  { ReactorTunables::TN_CRITICAL_MS,       1 },    // CRITICAL warning
+  { ReactorTunables::TN_MELTDOWN_MS,       1 },    // MELTDOWN: countdown to CHAOS
+  { ReactorTunables::TN_STAB_STEP_MS,      5 },    // STABILIZING: 5 steps
+  { ReactorTunables::TN_STARTUP_STEP_MS,   5 },    // STARTUP: 5 steps
+  { ReactorTunables::TN_FREEZE_STEP_MS,    5 },    // FREEZEDOWN: 5 steps
+  { ReactorTunables::TN_SHUTDOWN_STEP_MS,  5 },    // SHUTDOWN: 5 steps
+  { 0, 0 },                                        // DARK
+  { 0, 0 }                                         // CHAOS
+};
+
+#define T(a, g) { ACT_##a, GUARD_##g }
+#define NONE    { ACT_NONE, GUARD_ALWAYS }
+
+// Columns: OVERRIDE, STABILIZE, STARTUP, FREEZEDOWN, SHUTDOWN, EVENT,
+//          HEAT_CRITICAL, TIMEOUT
+const Transition TRANSITIONS[MODE_COUNT][INPUT_COUNT] PROGMEM = {
+  /* STABLE      */ { T(ARMING, ALWAYS), T(FREEZEDOWN, ALWAYS), T(STARTUP, ALWAYS), T(FREEZEDOWN, ALWAYS), T(SHUTDOWN, ALWAYS), T(TRIGGER_EVENT, NO_EVENT), NONE, NONE },
+  /* ARMING      */ { NONE, T(STABILIZING, ALWAYS), NONE, NONE, NONE, NONE, NONE, T(CRITICAL, ALWAYS) },
+  /* CRITICAL    */ { NONE, T(STABILIZING, ALWAYS), NONE, NONE, NONE, NONE, NONE, T(MELTDOWN, ALWAYS) },
+  /* MELTDOWN    */ { NONE, T(STABILIZING, ALWAYS), NONE, T(FREEZEDOWN, ALWAYS), NONE, NONE, NONE, T(CHAOS, ALWAYS) },
+  /* STABILIZING */ { T(ABORT_STABILIZING, ALWAYS), NONE, NONE, NONE, NONE, NONE, T(ABORT_STABILIZING, ALWAYS), T(FINISH_STABILIZING, ALWAYS) },
+  /* STARTUP     */ { T(ARMING, ALWAYS), NONE, NONE, NONE, NONE, NONE, NONE, T(FINISH_STARTUP, ALWAYS) },
+  /* FREEZEDOWN  */ { NONE, NONE, NONE, NONE, NONE, NONE, NONE, T(FINISH_FREEZEDOWN, ALWAYS) },
+  /* SHUTDOWN    */ { NONE, NONE, NONE, NONE, NONE, NONE, NONE, T(FINISH_SHUTDOWN, ALWAYS) },
+  /* DARK        */ { NONE, NONE, T(STARTUP, ALWAYS), NONE, NONE, NONE, NONE, NONE },
+  /* CHAOS       */ { NONE, NONE, T(STARTUP, ALWAYS), NONE, T(SHUTDOWN, ALWAYS), NONE, NONE, NONE }
+};
+
+#undef T
+#undef NONE
+
+void dispatch(Input input) {
+  const Transition* cell = &TRANSITIONS[currentMode][input];
+  uint8_t action = pgm_read_byte(&cell->action);
+  if (action == ACT_NONE) return;
+
+  GuardFn guard = (GuardFn)pgm_read_ptr(&GUARDS[pgm_read_byte(&cell->guard)]);
+  if (!guard()) return;
+
+  ActionFn fn = (ActionFn)pgm_read_ptr(&ACTIONS[action]);
+  fn();
+  if (action != ACT_TRIGGER_EVENT) enteredBy = input;
+}
+
+void force(Mode mode) {
+  switch (mode) {
+    case MODE_STABLE:      enterStable(); break;
+    case MODE_ARMING:      enterArming(); break;
+    case MODE_CRITICAL:    enterCritical(); break;
+    case MODE_MELTDOWN:    enterMeltdown(); break;
+    case MODE_STABILIZING: enterStabilizing(); break;
+    case MODE_STARTUP:     enterStartup(); break;
+    case MODE_FREEZEDOWN:  enterFreezedown(); break;
+    case MODE_SHUTDOWN:    enterShutdown(); break;
+    case MODE_DARK:        enterDark(); break;
+    case MODE_CHAOS:       enterChaos(); break;
+  }
+}
+
+void checkTimeout(unsigned long now) {
+  uint16_t limit = timeoutMs(currentMode);
+  if (limit == 0) return;
+  if (now - modeEnteredAt >= limit) dispatch(IN_TIMEOUT);
+}
+
+Input lastInput() {
+  return enteredBy;
+}
+
+uint16_t timeoutMs(uint8_t mode) {
+  uint8_t steps = pgm_read_byte(&MODE_TIMEOUTS[mode].steps);
+  if (!steps) return 0;
+  return ReactorTunables::get((ReactorTunables::Id)pgm_read_byte(&MODE_TIMEOUTS[mode].tunable)) * (uint16_t)steps;
+}
+
+// ======================= Transition Graph Dump =======================
+const __FlashStringHelper* modeName(uint8_t mode) {
+  switch (mode) {
+    case MODE_STABLE:      return F("STABLE");
+    case MODE_ARMING:      return F("ARMING");
+    case MODE_CRITICAL:    return F("CRITICAL");
+    case MODE_MELTDOWN:    return F("MELTDOWN");
+    case MODE_STABILIZING: return F("STABILIZING");
+    case MODE_STARTUP:     return F("STARTUP");
+    case MODE_FREEZEDOWN:  return F("FREEZEDOWN");
+    case MODE_SHUTDOWN:    return F("SHUTDOWN");
+    case MODE_DARK:        return F("DARK");
+    case MODE_CHAOS:       return F("CHAOS");
+    default:               return F("?");
+  }
+}
+
+static const __FlashStringHelper* inputName(uint8_t input) {
+  switch (input) {
+    case IN_OVERRIDE:      return F("OVERRIDE");
+    case IN_STABILIZE:     return F("STABILIZE");
+    case IN_STARTUP:       return F("STARTUP");
+    case IN_FREEZEDOWN:    return F("FREEZEDOWN");
+    case IN_SHUTDOWN:      return F("SHUTDOWN");
+    case IN_EVENT:         return F("EVENT");
+    case IN_HEAT_CRITICAL: return F("RUNAWAY");
+    case IN_TIMEOUT:       return F("TIMEOUT");
+    default:               return F("?");
+  }
+}
+
+static const __FlashStringHelper* actionName(uint8_t action) {
+  switch (action) {
+    case ACT_ABORT_STABILIZING:  return F("abort");
+    case ACT_FINISH_STABILIZING: return F("finish + sweep");
+    case ACT_FINISH_STARTUP:     return F("finish");
+    case ACT_FINISH_FREEZEDOWN:  return F("finish + sweep");
+    case ACT_FINISH_SHUTDOWN:    return F("finish");
+    case ACT_TRIGGER_EVENT:      return F("trigger event");
+    default:                     return nullptr;
+  }
+}
+
+void dumpTransitionGraph(Print& out) {
+  out.println(F("digraph reactor {"));
+  for (uint8_t mode = 0; mode < MODE_COUNT; ++mode) {
+    for (uint8_t input = 0; input < INPUT_COUNT; ++input) {
+      const Transition* cell = &TRANSITIONS[mode][input];
+      uint8_t action = pgm_read_byte(&cell->action);
+      if (action == ACT_NONE) continue;
+
+      uint8_t target = pgm_read_byte(&ACTION_TARGET[action]);
+      if (action == ACT_TRIGGER_EVENT) target = mode;
+
+      out.print(F("  "));
+      out.print(modeName(mode));
+      out.print(F(" -> "));
+      out.print(modeName(target));
+      out.print(F(" [label=\""));
+      out.print(inputName(input));
+      if (input == IN_TIMEOUT) {
+        out.print(' ');
+        out.print(timeoutMs(mode));
+        out.print(F("ms"));
+      }
+      if (pgm_read_byte(&cell->guard) == GUARD_NO_EVENT) out.print(F(" [no event]"));
+      const __FlashStringHelper* name = actionName(action);
+      if (name) {
+        out.print(F(" / "));
+        out.print(name);
+      }
+      out.println(F("\"];"));
+    }
+  }
+  out.println(F("}"));
+}
+
 } // namespace ReactorStateMachine
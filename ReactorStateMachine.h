@@ -11,6 +11,20 @@ namespace ReactorStateMachine {
   extern unsigned long startupStartAt;
   extern unsigned long shutdownStartAt;
   extern unsigned long meltdownStartAt;    // Meltdown countdown timer (10 seconds)
+  extern unsigned long modeEnteredAt;      // When the current mode was entered
+
+  // Inputs that index the transition table (one column each)
+  enum Input : uint8_t {
+    IN_OVERRIDE,
+    IN_STABILIZE,
+    IN_STARTUP,
+    IN_FREEZEDOWN,
+    IN_SHUTDOWN,
+    IN_EVENT,
+    IN_HEAT_CRITICAL,  // heat reached the containment limit
+    IN_TIMEOUT,        // the current mode's timed window elapsed
+    INPUT_COUNT
+  };
 
   // Get current mode
   Mode getMode();
@@ -31,4 +45,25 @@ namespace ReactorStateMachine {
   void abortStabilizingToMeltdown();
   void finishStabilizingToStable();
   void finishFreezedownToStable();
+
+  // Table-driven dispatch: look up [mode][input], check guard, run action
+  void dispatch(Input input);
+
+  // Enter a mode directly, bypassing the table (console / load tests)
+  void force(Mode mode);
+
+  // Input that made the last mode change; INPUT_COUNT if it bypassed the table
+  Input lastInput();
+
+  // Dispatch IN_TIMEOUT once the current mode's window has elapsed
+  void checkTimeout(unsigned long now);
+
+  // Timeout column of the transition table (0 = mode has no timeout)
+  uint16_t timeoutMs(uint8_t mode);
+
+  // Upper-case mode label kept in flash (for Serial output)
+  const __FlashStringHelper* modeName(uint8_t mode);
+
+  // Print the transition table as a Graphviz digraph
+  void dumpTransitionGraph(Print& out);
 }
@@ -0,0 +1,169 @@
+#include "ReactorStats.h"
+#include "ReactorEepromMap.h"
+#include "ReactorStateMachine.h"
+#include <EEPROM.h>
+#include <util/crc16.h>
+
+namespace ReactorStats {
+
+namespace {
+  struct Totals {
+    uint16_t counters[COUNTER_COUNT];
+    uint32_t dwellS[MODE_COUNT];
+    uint32_t uptimeS;
+  };
+
+  // One log entry; the slot with the highest valid sequence number wins.
+  // A new record always goes to the slot after the newest, so a write cut
+  // short by power loss only costs that record (its CRC fails) and the
+  // previous one is still intact.
+  struct Record {
+    uint16_t seq;
+    Totals   totals;
+    uint16_t crc;     // CRC-16/CCITT over seq and totals
+  };
+
+  const int     SLOT_SIZE = 64;
+  const uint8_t SLOTS = (ReactorEepromMap::STATS_END - ReactorEepromMap::STATS_BASE) / SLOT_SIZE;
+  static_assert(sizeof(Record) <= SLOT_SIZE, "stats record outgrew its slot");
+
+  // Schedule: periodic flush, plus an early one after a counter bump (but
+  // never closer together than the minimum gap). With 16 slots a cell is
+  // rewritten at most every 16 x 5 min, i.e. 18 times a day of nonstop use:
+  // 100k cycles last over 15 years, and routine 10 min flushes twice that.
+  const unsigned long FLUSH_PERIOD_MS = 600000UL;
+  const unsigned long FLUSH_MIN_GAP_MS = 300000UL;
+
+  Totals        totals;
+  uint16_t      seq = 0;
+  uint8_t       nextSlot = 0;
+  bool          dirtyCounter = false;
+  unsigned long secondAt = 0;
+  unsigned long flushedAt = 0;
+
+  // Staged copy being written (totals may keep changing meanwhile)
+  Record  staged;
+  int     writeStep = -1;   // -1 = idle
+  int     writeBase = 0;
+
+  uint16_t crcOf(const Record& r) {
+    const uint8_t* p = (const uint8_t*)&r;
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < offsetof(Record, crc); ++i) crc = _crc_ccitt_update(crc, p[i]);
+    return crc;
+  }
+
+  inline int slotAddr(uint8_t slot) {
+    return ReactorEepromMap::STATS_BASE + (int)slot * SLOT_SIZE;
+  }
+
+  // Wrap-safe "a is newer than b"
+  inline bool newer(uint16_t a, uint16_t b) {
+    return (int16_t)(a - b) > 0;
+  }
+
+  const __FlashStringHelper* counterName(uint8_t c) {
+    switch (c) {
+      case ST_MELTDOWNS:       return F("meltdowns");
+      case ST_CHAOS:           return F("chaos");
+      case ST_SHUTDOWNS:       return F("shutdowns");
+      case ST_EVENTS_RESOLVED: return F("events_ok");
+      case ST_EVENTS_FAILED:   return F("events_failed");
+      case ST_SECRETS:         return F("secrets");
+      default:                 return F("?");
+    }
+  }
+
+  void startFlush() {
+    if (writeStep >= 0) return;
+    staged.seq = ++seq;
+    staged.totals = totals;
+    staged.crc = crcOf(staged);
+    writeBase = slotAddr(nextSlot);
+    nextSlot = (nextSlot + 1) % SLOTS;
+    writeStep = 0;
+    dirtyCounter = false;
+    flushedAt = millis();
+  }
+}
+
+void begin() {
+  memset(&totals, 0, sizeof(totals));
+  seq = 0;
+  nextSlot = 0;
+  bool found = false;
+  for (uint8_t s = 0; s < SLOTS; ++s) {
+    Record r;
+    EEPROM.get(slotAddr(s), r);
+    if (r.crc != crcOf(r)) continue;
+    if (!found || newer(r.seq, seq)) {
+      found = true;
+      seq = r.seq;
+      totals = r.totals;
+      nextSlot = (s + 1) % SLOTS;
+    }
+  }
+  writeStep = -1;
+  dirtyCounter = false;
+  secondAt = millis();
+  flushedAt = secondAt;
+}
+
+void bump(Counter c) {
+  if (totals.counters[c] != 0xFFFF) ++totals.counters[c];
+  dirtyCounter = true;
+}
+
+void tick(Mode mode) {
+  unsigned long now = millis();
+  while (now - secondAt >= 1000) {
+    secondAt += 1000;
+    ++totals.dwellS[mode];
+    ++totals.uptimeS;
+  }
+
+  if (writeStep < 0) {
+    unsigned long since = now - flushedAt;
+    if (since >= FLUSH_PERIOD_MS || (dirtyCounter && since >= FLUSH_MIN_GAP_MS)) startFlush();
+    return;
+  }
+
+  // One byte per loop, only while the EEPROM is idle (shared with the trace
+  // snapshot); update() skips bytes that already match
+  if (!eeprom_is_ready()) return;
+  EEPROM.update(writeBase + writeStep, ((const uint8_t*)&staged)[writeStep]);
+  if (++writeStep >= (int)sizeof(Record)) writeStep = -1;
+}
+
+void save() {
+  startFlush();
+}
+
+void reset() {
+  memset(&totals, 0, sizeof(totals));
+  dirtyCounter = true;
+}
+
+void print(Print& out) {
+  out.print(F("# stats seq "));
+  out.print(seq);
+  out.print(F(" slot "));
+  out.print((nextSlot + SLOTS - 1) % SLOTS);
+  out.print('/');
+  out.println(SLOTS);
+  for (uint8_t i = 0; i < COUNTER_COUNT; ++i) {
+    out.print(counterName(i));
+    out.print(' ');
+    out.println(totals.counters[i]);
+  }
+  out.print(F("uptime_s "));
+  out.println(totals.uptimeS);
+  for (uint8_t m = 0; m < MODE_COUNT; ++m) {
+    out.print(F("dwell_s "));
+    out.print(ReactorStateMachine::modeName(m));
+    out.print(' ');
+    out.println(totals.dwellS[m]);
+  }
+}
+
+} // namespace ReactorStats
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ReactorTypes.h"
+
+namespace ReactorStats {
+
+// Lifetime counters kept across power cycles. Updates only touch RAM; a
+// snapshot is written to a wear-leveled EEPROM log on a schedule, one byte
+// per loop, so the loop never waits on the EEPROM.
+enum Counter : uint8_t {
+  ST_MELTDOWNS,
+  ST_CHAOS,
+  ST_SHUTDOWNS,       // shutdown sequences that reached DARK
+  ST_EVENTS_RESOLVED,
+  ST_EVENTS_FAILED,
+  ST_SECRETS,
+  COUNTER_COUNT
+};
+
+// Load the newest valid record (zeroed totals if none)
+void begin();
+
+void bump(Counter c);
+
+// Call once per loop: accrues dwell/uptime seconds and advances a pending flush
+void tick(Mode mode);
+
+// Start a flush now instead of waiting for the schedule
+void save();
+
+// Zero the RAM totals (persisted by the next flush)
+void reset();
+
+void print(Print& out);
+
+} // namespace ReactorStats
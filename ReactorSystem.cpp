@@ -5,6 +5,7 @@
 #include "ReactorAudio.h"
 #include "ReactorHeat.h"
 #include "ReactorHeatControl.h"
+#include "ReactorThermal.h"
 #include "ReactorEvents.h"
 #include "ReactorSecrets.h"
 #include "ReactorSequences.h"
@@ -14,6 +15,16 @@
 #include "ReactorSweep.h"
 #include "ReactorUIFrames.h"
 #include "ReactorStateMachine.h"
+#include "ReactorLeds.h"
+#include "ReactorTrace.h"
+#include "ReactorConsole.h"
+#include "ReactorReplay.h"
+#include "ReactorDiag.h"
+#include "ReactorFuzz.h"
+#include "ReactorStats.h"
+#include "ReactorTunables.h"
+#include "ReactorTelemetry.h"
+#include "ReactorMirror.h"
 
 #include <Wire.h>
 #include <math.h>
@@ -30,32 +41,17 @@ inline void buzzerOff() { ReactorAudio::off(); }
 inline void buzzerTone(unsigned int hz) { ReactorAudio::toneHz(hz); }
 
 // ======================= Pins =======================
-const uint8_t PIN_LED_MELTDOWN      = 13;
-const uint8_t PIN_LED_STABLE        = 12;
-const uint8_t PIN_LED_STARTUP       = 11;
-const uint8_t PIN_LED_FREEZEDOWN    = 9;
+// Indicator LED pins live in ReactorLeds
 const uint8_t PIN_BUZZER            = 7;
 
 // ======================= Tunables =======================
-// Arming (3-2-1)
-const unsigned long ARM_STEP_MS   = 500;
-const uint8_t       ARM_BLINKS    = 5;
-const unsigned int  ARM_CHIRP_HZ  = 1600;
-
-// Meltdown constants moved to ReactorMeltdown
-
-// Dark mode (post-shutdown)
-const unsigned long DARK_SUCCESS_DISPLAY_MS = 2000; // Show success for 2 seconds
-
-// Event alarm sound (urgent alternating tone)
-const unsigned long EVENT_ALARM_PERIOD_MS = 300;
-const int           EVENT_ALARM_LOW_HZ    = 900;
-const int           EVENT_ALARM_HIGH_HZ   = 1400;
+// Sequence timing, the frame period and the core slew rates are runtime
+// tunables (ReactorTunables); arming, meltdown and event constants live in
+// their own modules.
 
 // Stable "breathing" animation
 const uint16_t STABLE_BREATH_MS   = 2600; // full inhale+exhale period
 const uint8_t  STABLE_BREATH_AMPL = 4;    // +/- percent swing (keep small)
-const uint16_t UI_FRAME_MS = 100;   // ~10 FPS
 unsigned long  uiFrameAt   = 0;
 
 // Timed mute window
@@ -67,15 +63,20 @@ const unsigned long ACK_SILENCE_MS = 8000; // 8 seconds
 
 // ======================= Setup =======================
 void begin() {
+  ReactorDiag::begin();
+  ReactorTunables::begin();
+  Serial.begin(115200);
+  ReactorTrace::begin();
+  ReactorStats::begin();
+  ReactorConsole::begin();
+
   Wire.setClock(400000);
 
-  pinMode(PIN_LED_MELTDOWN,     OUTPUT);
-  pinMode(PIN_LED_STABLE,       OUTPUT);
-  pinMode(PIN_LED_STARTUP,      OUTPUT);
-  pinMode(PIN_LED_FREEZEDOWN,   OUTPUT);
+  ReactorLeds::begin();
   ReactorAudio::begin(PIN_BUZZER);
   ReactorButtons::begin();
   ReactorHeat::begin();
+  ReactorHeatControl::begin();
   ReactorEvents::begin();
   ReactorSecrets::begin();
   ReactorSequences::begin();
@@ -83,9 +84,6 @@ void begin() {
   ReactorChaos::begin();
   ReactorDark::begin();
 
-  // Seed chaos effects
-  randomSeed(analogRead(A0));
-
   if (!ReactorUI::begin()) {
     while (true) { /* halt if OLED missing */ }
   }
@@ -101,11 +99,22 @@ void begin() {
   uiFrameAt  = now;
 
   ReactorStateMachine::enterStable();
+
+  // Seed chaos effects; the seed is kept with the recorded session
+  ReactorReplay::begin(analogRead(A0));
+  ReactorLeds::commit();
+
+#ifdef REACTOR_DUMP_TRANSITIONS
+  ReactorStateMachine::dumpTransitionGraph(Serial);
+#endif
 }
 
 // ======================= Main Loop =======================
-void tick() {
-  // Update debounce state
+// One pass of inputs, transitions and mode work (may return early)
+static void update() {
+  // Update debounce state (replayed edges are injected first)
+  ReactorReplay::tick();
+  ReactorFuzz::tick();
   ReactorButtons::update();
 
   // Read edges ONCE per loop
@@ -117,6 +126,26 @@ void tick() {
   bool eventFell       = ReactorButtons::eventBtn.fell();
   bool ackFell         = ReactorButtons::ackBtn.fell();
 
+  // ---- Trace button edges ----
+  if (overrideFell)   ReactorTrace::record(ReactorTrace::TR_BUTTON, 'O');
+  if (stabilizeFell)  ReactorTrace::record(ReactorTrace::TR_BUTTON, 'S');
+  if (startupFell)    ReactorTrace::record(ReactorTrace::TR_BUTTON, 'U');
+  if (freezedownFell) ReactorTrace::record(ReactorTrace::TR_BUTTON, 'F');
+  if (shutdownFell)   ReactorTrace::record(ReactorTrace::TR_BUTTON, 'D');
+  if (eventFell)      ReactorTrace::record(ReactorTrace::TR_BUTTON, 'E');
+  if (ackFell)        ReactorTrace::record(ReactorTrace::TR_BUTTON, 'A');
+
+  // ---- ACK chords (the second press is consumed) ----
+  // ACK + EVENT: hidden diagnostics screen; ACK + STABILIZE: heat trend in STABLE
+  if (eventFell && ReactorButtons::ackBtn.isPressed()) {
+    ReactorDiag::toggleScreen();
+    eventFell = false;
+  }
+  if (stabilizeFell && ReactorButtons::ackBtn.isPressed()) {
+    ReactorUI::toggleTrend();
+    stabilizeFell = false;
+  }
+
   // ---- Secret sequence capture ----
   char code = 0;
   if (overrideFell)   code = 'O';
@@ -129,6 +158,9 @@ void tick() {
     ReactorSecrets::captureInput(code);
   }
 
+  // ---- Invariants (-DREACTOR_CHECKS; every pass, an incident can end it early below) ----
+  ReactorFuzz::checkInvariants(millis());
+
   // ---- Event resolution first ----
   if (ReactorEvents::handleInput(overrideFell, stabilizeFell, startupFell,
                                  freezedownFell, shutdownFell, eventFell)) {
@@ -137,44 +169,23 @@ void tick() {
   }
 
   // ---- Heat emergency check ----
-  // If stabilizing and heat reaches critical, trigger meltdown automatically
-  if (ReactorStateMachine::getMode() == MODE_STABILIZING && ReactorHeat::getLevel() >= 11.5f) {
-    ReactorStateMachine::abortStabilizingToMeltdown();
+  // If the core is running away while stabilizing, the table aborts to meltdown.
+  // It only counts once the rods and pumps have reached the mode's demand: out
+  // of a meltdown they start fully out and stopped, and the core stays at the
+  // top of the bar until they catch up.
+  if (ReactorThermal::runaway() && ReactorThermal::settled()) {
+    ReactorStateMachine::dispatch(ReactorStateMachine::IN_HEAT_CRITICAL);
   }
 
   // ---- Button -> Mode transitions ----
-  if (overrideFell) {
-    if (ReactorStateMachine::getMode() == MODE_STABLE)   ReactorStateMachine::enterArming();
-    else if (ReactorStateMachine::getMode() == MODE_STABILIZING) ReactorStateMachine::abortStabilizingToMeltdown();
-    else if (ReactorStateMachine::getMode() == MODE_STARTUP)     ReactorStateMachine::enterArming();
-  }
-
-  if (stabilizeFell) {
-    if (ReactorStateMachine::getMode() == MODE_STABLE)        ReactorStateMachine::enterFreezedown(); // shortcut
-    else if (ReactorStateMachine::getMode() == MODE_ARMING)   ReactorStateMachine::enterStabilizing();
-    else if (ReactorStateMachine::getMode() == MODE_CRITICAL) ReactorStateMachine::enterStabilizing();
-    else if (ReactorStateMachine::getMode() == MODE_MELTDOWN) ReactorStateMachine::enterStabilizing();
-    // In CHAOS, stabilize is ignored (only Startup can recover)
-  }
-
-  if (startupFell) {
-    if (ReactorStateMachine::getMode() == MODE_STABLE)  ReactorStateMachine::enterStartup();
-    else if (ReactorStateMachine::getMode() == MODE_DARK) ReactorStateMachine::enterStartup(); // wake from dark
-    else if (ReactorStateMachine::getMode() == MODE_CHAOS) ReactorStateMachine::enterStartup(); // reboot from chaos
-  }
-
-  if (freezedownFell && (ReactorStateMachine::getMode() == MODE_STABLE || ReactorStateMachine::getMode() == MODE_MELTDOWN)) {
-    ReactorStateMachine::enterFreezedown();
-  }
-
-  if (shutdownFell && (ReactorStateMachine::getMode() == MODE_STABLE || ReactorStateMachine::getMode() == MODE_CHAOS)) {
-    ReactorStateMachine::enterShutdown();
-  }
-
-  // Event button triggers random event in stable mode
-  if (eventFell && ReactorStateMachine::getMode() == MODE_STABLE && !ReactorEvents::isActive()) {
-    ReactorEvents::trigger();
-  }
+  // Each edge is one lookup in ReactorStateMachine's transition table;
+  // several edges in one loop chain through in this order.
+  if (overrideFell)   ReactorStateMachine::dispatch(ReactorStateMachine::IN_OVERRIDE);
+  if (stabilizeFell)  ReactorStateMachine::dispatch(ReactorStateMachine::IN_STABILIZE);
+  if (startupFell)    ReactorStateMachine::dispatch(ReactorStateMachine::IN_STARTUP);
+  if (freezedownFell) ReactorStateMachine::dispatch(ReactorStateMachine::IN_FREEZEDOWN);
+  if (shutdownFell)   ReactorStateMachine::dispatch(ReactorStateMachine::IN_SHUTDOWN);
+  if (eventFell)      ReactorStateMachine::dispatch(ReactorStateMachine::IN_EVENT);
 
   // If ACK pressed: start/extend mute and silence immediately
   if (ackFell) {
@@ -199,72 +210,23 @@ void tick() {
   ReactorSequences::tick(ReactorStateMachine::getMode());
 
   // ---- Check for sequence completions ----
+  // Timed windows (arming, critical, meltdown countdown, sequences) live in
+  // the timeout column of the transition table.
   unsigned long now = millis();
-  
-  // Arming auto-completes after 5 seconds -> enters CRITICAL
-  if (ReactorStateMachine::getMode() == MODE_ARMING) {
-    unsigned long elapsed = now - ReactorStateMachine::armingStartAt;
-    if (elapsed >= 5000) {  // 5 second countdown
-      ReactorStateMachine::enterCritical();
-    }
-  }
-  
-  // Critical auto-completes after 3 seconds -> enters MELTDOWN
-  if (ReactorStateMachine::getMode() == MODE_CRITICAL) {
-    unsigned long elapsed = now - ReactorStateMachine::criticalStartAt;
-    if (elapsed >= 3000) {  // 3 second critical warning
-      ReactorStateMachine::enterMeltdown();
-    }
-  }
-  
-  // Stabilizing completes after STAB_TOTAL_STEPS steps
-  if (ReactorStateMachine::getMode() == MODE_STABILIZING) {
-    unsigned long elapsed = now - ReactorStateMachine::stabStartAt;
-    unsigned long totalMs = (unsigned long)(ReactorSequences::getTotalSteps(MODE_STABILIZING)) * 1000;
-    if (elapsed >= totalMs) {
-      buzzerOff();
-      ReactorStateMachine::finishStabilizingToStable();
-    }
-  }
-  
-  // Startup transitions to Stabilizing after STARTUP_TOTAL_STEPS steps
-  if (ReactorStateMachine::getMode() == MODE_STARTUP) {
-    unsigned long elapsed = now - ReactorStateMachine::startupStartAt;
-    unsigned long totalMs = (unsigned long)(ReactorSequences::getTotalSteps(MODE_STARTUP)) * 2000;
-    if (elapsed >= totalMs) {
-      buzzerOff();
-      digitalWrite(PIN_LED_STARTUP, LOW);
-      ReactorStateMachine::enterStabilizing();
-    }
-  }
-  
-  // Freezedown completes after FREEZE_TOTAL_STEPS steps
-  if (ReactorStateMachine::getMode() == MODE_FREEZEDOWN) {
-    unsigned long elapsed = now - ReactorStateMachine::freezeStartAt;
-    unsigned long totalMs = (unsigned long)(ReactorSequences::getTotalSteps(MODE_FREEZEDOWN)) * 1200;
-    if (elapsed >= totalMs) {
-      buzzerOff();
-      ReactorStateMachine::finishFreezedownToStable();
-    }
-  }
-  
-  // Shutdown transitions to Dark after SHUTDOWN_TOTAL_STEPS steps
-  if (ReactorStateMachine::getMode() == MODE_SHUTDOWN) {
-    unsigned long elapsed = now - ReactorStateMachine::shutdownStartAt;
-    unsigned long totalMs = (unsigned long)(ReactorSequences::getTotalSteps(MODE_SHUTDOWN)) * 2000;
-    if (elapsed >= totalMs) {
-      buzzerOff();
-      ReactorStateMachine::enterDark();
-    }
-  }
+  ReactorStateMachine::checkTimeout(now);
 
   // ---- Event and secrets tick ----
   ReactorEvents::tick();
   ReactorSecrets::tick();
 
-  if (ReactorStateMachine::getMode() != MODE_CHAOS && ReactorStateMachine::getMode() != MODE_DARK && (now - uiFrameAt) >= UI_FRAME_MS) {
+  if (ReactorStateMachine::getMode() != MODE_CHAOS && ReactorStateMachine::getMode() != MODE_DARK && (now - uiFrameAt) >= ReactorTunables::get(ReactorTunables::TN_UI_FRAME_MS)) {
     uiFrameAt = now;
-    ReactorUIFrames::renderActiveUIFrame(ReactorStateMachine::getMode(), ReactorStateMachine::meltdownStartAt);  // repaints current screen (incl. progress bars)
+    uint32_t c0 = ReactorDiag::cycles();
+    unsigned long us0 = micros();
+    if (ReactorDiag::screenActive()) ReactorDiag::renderScreen();
+    else ReactorUIFrames::renderActiveUIFrame(ReactorStateMachine::getMode(), ReactorStateMachine::meltdownStartAt);  // repaints current screen (incl. progress bars)
+    ReactorDiag::addCycles(ReactorDiag::PROBE_FRAME, ReactorDiag::cycles() - c0);
+    ReactorDiag::frameDone(micros() - us0);
   }
 
   // Heat bar (skip during CHAOS and DARK)
@@ -278,6 +240,23 @@ void tick() {
   ReactorAudio::tickMute();
 }
 
+void tick() {
+  uint32_t c0 = ReactorDiag::cycles();
+
+  // Serial diagnostics (non-blocking)
+  ReactorConsole::poll();
+  ReactorTrace::tick();
+  ReactorStats::tick(ReactorStateMachine::getMode());
+
+  update();
+
+  // Push indicator LED changes once per loop
+  ReactorLeds::commit();
+  ReactorDiag::loopDone(ReactorStateMachine::getMode(), ReactorDiag::cycles() - c0);
+  ReactorTelemetry::tick(ReactorStateMachine::getMode());
+  ReactorMirror::tick();
+}
+
 } // namespace ReactorSystem
 
 
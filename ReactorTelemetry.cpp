@@ -0,0 +1,120 @@
+#include "ReactorTelemetry.h"
+#include "ReactorTunables.h"
+#include "ReactorDiag.h"
+#include "ReactorHeat.h"
+#include "ReactorThermal.h"
+#include "ReactorSequences.h"
+#include "ReactorEvents.h"
+#include "ReactorAudio.h"
+#include "ReactorSecrets.h"
+#include <util/crc16.h>
+
+namespace ReactorTelemetry {
+
+namespace {
+  const uint8_t PAYLOAD_LEN = 25;
+
+  unsigned long frameAt = 0;
+  uint8_t       seq = 0;
+  uint16_t      drops = 0;
+
+  uint8_t* put8(uint8_t* p, uint8_t v)   { *p++ = v; return p; }
+  uint8_t* put16(uint8_t* p, uint16_t v) { *p++ = (uint8_t)v; *p++ = (uint8_t)(v >> 8); return p; }
+  uint8_t* put32(uint8_t* p, uint32_t v) { p = put16(p, (uint16_t)v); return put16(p, (uint16_t)(v >> 16)); }
+
+  inline uint16_t clamp16(uint32_t v) { return v > 0xFFFF ? 0xFFFF : (uint16_t)v; }
+
+  // Consistent Overhead Byte Stuffing: no 0x00 in the output, one byte of
+  // overhead for frames under 254 bytes. Returns the encoded length.
+  uint8_t cobsEncode(const uint8_t* in, uint8_t len, uint8_t* out) {
+    uint8_t* code = out;
+    uint8_t* o = out + 1;
+    uint8_t run = 1;
+    for (uint8_t i = 0; i < len; ++i) {
+      if (in[i]) {
+        *o++ = in[i];
+        ++run;
+      } else {
+        *code = run;
+        code = o++;
+        run = 1;
+      }
+    }
+    *code = run;
+    return (uint8_t)(o - out);
+  }
+
+  uint8_t buildPayload(uint8_t* buf, Mode mode, unsigned long now) {
+    ReactorDiag::Window w;
+    ReactorDiag::takeWindow(w);
+
+    uint8_t flags = 0;
+    if (ReactorAudio::isMuted())     flags |= 0x01;
+    if (ReactorSecrets::isGodMode()) flags |= 0x02;
+    if (ReactorThermal::runaway())   flags |= 0x04;
+
+    uint8_t* p = buf;
+    p = put8(p, 'T');
+    p = put8(p, seq++);
+    p = put32(p, now);
+    p = put8(p, mode);
+    p = put16(p, ReactorHeat::levelQ8());
+    p = put8(p, ReactorSequences::getStep(mode));
+    p = put8(p, ReactorEvents::activeCount());
+    p = put8(p, (uint8_t)ReactorEvents::getRequiredButton());
+    p = put8(p, flags);
+    p = put16(p, w.loops);
+    p = put16(p, w.loops ? clamp16(w.sumLoopUs / w.loops) : 0);
+    p = put32(p, w.maxLoopUs);
+    p = put16(p, clamp16(w.maxFrameUs));
+    p = put16(p, drops);
+    return (uint8_t)(p - buf);
+  }
+}
+
+void tick(Mode mode) {
+  uint16_t period = ReactorTunables::get(ReactorTunables::TN_TELEMETRY_MS);
+  if (!period) return;
+  unsigned long now = millis();
+  if (now - frameAt < period) return;
+  frameAt = now;
+
+  uint8_t payload[PAYLOAD_LEN];
+  uint8_t len = buildPayload(payload, mode, now);
+  if (!send(payload, len) && drops != 0xFFFF) ++drops;
+}
+
+uint16_t dropped() {
+  return drops;
+}
+
+bool active() {
+  return ReactorTunables::get(ReactorTunables::TN_TELEMETRY_MS) != 0;
+}
+
+bool send(const uint8_t* payload, uint8_t len) {
+  // The core's TX ring is interrupt-driven; writing only when the whole
+  // frame fits means Serial.write() never waits on a slow host
+  uint8_t n = wireLength(len);
+  if (Serial.availableForWrite() < n) return false;
+
+  uint8_t raw[MAX_PAYLOAD + 2];
+  memcpy(raw, payload, len);
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < len; ++i) crc = _crc_ccitt_update(crc, raw[i]);
+  raw[len++] = (uint8_t)crc;
+  raw[len++] = (uint8_t)(crc >> 8);
+
+  uint8_t wire[MAX_PAYLOAD + 5];
+  wire[0] = 0;
+  uint8_t w = 1 + cobsEncode(raw, len, wire + 1);
+  wire[w++] = 0;
+  Serial.write(wire, w);
+  return true;
+}
+
+uint8_t headroom() {
+  return ReactorTunables::get(ReactorTunables::TN_TELEMETRY_MS) ? wireLength(PAYLOAD_LEN) : 0;
+}
+
+} // namespace ReactorTelemetry
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+#include "ReactorTypes.h"
+
+namespace ReactorTelemetry {
+
+// Binary status frames on Serial every telemetry_ms (ReactorTunables; 0 =
+// off). Each frame is a COBS-encoded payload plus CRC-16, wrapped in 0x00
+// delimiters, so a host can pick frames out of interleaved console text;
+// tools/telemetry_decode.py turns a capture into CSV.
+//
+// Payload (little-endian), FRAME_VERSION 1:
+//   u8  type ('T')       u8  seq            u32 millis
+//   u8  mode             u16 heat (Q8.8)    u8  sequence step
+//   u8  live incidents   u8  required button
+//   u8  flags (bit0 muted, bit1 god mode, bit2 runaway)
+//   u16 loops            u16 mean loop us   u32 max loop us
+//   u16 max frame us     u16 dropped frames (total)
+const uint8_t FRAME_VERSION = 1;
+
+// Call once per loop; emits a frame when one is due
+void tick(Mode mode);
+
+uint16_t dropped();
+
+// telemetry_ms is set
+bool active();
+
+// Shared framing for other binary streams (ReactorMirror): CRC, COBS and
+// delimiters around payload[0..len). Writes nothing and returns false unless
+// the whole frame fits in the TX buffer now. len <= MAX_PAYLOAD.
+const uint8_t MAX_PAYLOAD = 64;
+bool send(const uint8_t* payload, uint8_t len);
+
+// Encoded size of a frame with len payload bytes
+inline uint8_t wireLength(uint8_t len) { return len + 2 + 1 + 2; }
+
+// TX space other streams should leave free for status frames (0 when off)
+uint8_t headroom();
+
+} // namespace ReactorTelemetry
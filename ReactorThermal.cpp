@@ -0,0 +1,80 @@
+#include "ReactorThermal.h"
+#include "ReactorTunables.h"
+
+namespace ReactorThermal {
+
+namespace {
+  const uint16_t LEVEL_MAX_Q8    = 12 << 8;          // top of the heat bar
+  const uint16_t CRITICAL_Q8     = (23 << 8) / 2;    // 11.5 levels
+  const uint8_t  K_AMBIENT       = 8;                // structural losses
+
+  Inputs   demand;
+  uint8_t  rodPos  = 0;
+  uint8_t  flowNow = 0;
+  uint16_t tempQ8  = 0;
+  int32_t  lastNet = 0;     // last step's generation minus cooling (Q8.8 * k)
+
+  uint8_t approach(uint8_t cur, uint8_t want, uint8_t rate) {
+    if (cur < want) return (want - cur > rate) ? cur + rate : want;
+    if (cur > want) return (cur - want > rate) ? cur - rate : want;
+    return cur;
+  }
+}
+
+void begin(uint16_t levelQ8) {
+  demand.power = 128;
+  demand.rods  = 128;
+  demand.flow  = 64;
+  demand.cryo  = 0;
+  rodPos  = demand.rods;
+  flowNow = demand.flow;
+  lastNet = 0;
+  setLevelQ8(levelQ8);
+}
+
+void setInputs(const Inputs& in) {
+  demand = in;
+}
+
+const Inputs& inputs() {
+  return demand;
+}
+
+// T += (gen - k * T) / 256 per step: equilibrium gen / k levels, tau 256 / k steps
+void step() {
+  // Rod travel and pump slew per step are tunables (defaults 16 and 8:
+  // full stroke in ~16 steps, pumps lag rods)
+  rodPos  = approach(rodPos, demand.rods, ReactorTunables::get(ReactorTunables::TN_ROD_TRAVEL));
+  flowNow = approach(flowNow, demand.flow, ReactorTunables::get(ReactorTunables::TN_PUMP_SLEW));
+
+  uint16_t gen = ((uint16_t)demand.power * (uint8_t)(255 - rodPos)) >> 8;   // 0..254
+  uint8_t  k   = K_AMBIENT + (flowNow >> 3) + (demand.cryo >> 2);           // 8..103
+
+  lastNet = ((int32_t)gen << 8) - (int32_t)k * tempQ8;
+  int32_t t = (int32_t)tempQ8 + (lastNet >> 8);
+  if (t < 0) t = 0;
+  if (t > LEVEL_MAX_Q8) t = LEVEL_MAX_Q8;
+  tempQ8 = (uint16_t)t;
+}
+
+uint16_t levelQ8() {
+  return tempQ8;
+}
+
+void setLevelQ8(uint16_t q8) {
+  tempQ8 = q8 > LEVEL_MAX_Q8 ? LEVEL_MAX_Q8 : q8;
+}
+
+uint8_t rodPosition() {
+  return rodPos;
+}
+
+bool runaway() {
+  return tempQ8 >= CRITICAL_Q8 && lastNet > 0;
+}
+
+bool settled() {
+  return rodPos == demand.rods && flowNow == demand.flow;
+}
+
+} // namespace ReactorThermal
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorThermal {
+
+// Lumped core model stepped at a fixed interval by ReactorHeat. Temperature
+// is expressed in heat-bar levels as Q8.8 (0 .. 12 << 8). Settled, the core
+// sits at (generated heat / cooling conductance) levels; the conductance also
+// sets how fast it gets there.
+
+// Operator-side demands, 0..255 each. Rods and pumps travel toward their
+// demand over several steps; power and cryo act at once.
+struct Inputs {
+  uint8_t power;  // reactivity demand
+  uint8_t rods;   // control rod insertion (255 = fully in)
+  uint8_t flow;   // coolant pump speed
+  uint8_t cryo;   // cryogenic cooling
+};
+
+void begin(uint16_t levelQ8);
+void setInputs(const Inputs& in);
+const Inputs& inputs();
+
+// One fixed timestep
+void step();
+
+uint16_t levelQ8();
+void setLevelQ8(uint16_t q8);   // forced jump (cryo dump); inputs unchanged
+uint8_t rodPosition();
+
+// Above the critical level with generation still beating cooling
+bool runaway();
+
+// Rods and pumps have reached their demand
+bool settled();
+
+} // namespace ReactorThermal
@@ -0,0 +1,183 @@
+#include "ReactorTrace.h"
+#include "ReactorTypes.h"
+#include "ReactorEepromMap.h"
+#include <EEPROM.h>
+
+namespace ReactorTrace {
+
+namespace {
+  // Ring of fixed-size binary records; power of two so wrap is a mask
+  const uint8_t TRACE_SIZE = 64;
+  const uint8_t TRACE_MASK = TRACE_SIZE - 1;
+
+  struct Record {
+    uint8_t  kind;
+    uint8_t  arg;
+    uint16_t stamp;  // low 16 bits of millis() (high bits via TR_EPOCH)
+  };
+
+  Record   ring[TRACE_SIZE];
+  uint8_t  head = 0;        // next slot to write
+  uint8_t  count = 0;       // valid records (<= TRACE_SIZE)
+  uint16_t lastEpoch = 0;   // high word of the most recent record
+  uint16_t tailEpoch = 0;   // high word in effect at the oldest record
+
+  // EEPROM snapshot (header: magic, count, tailEpoch; then oldest-first records).
+  // The ring keeps recording while the copy trickles out, so the records are
+  // staged oldest-first when the snapshot starts.
+  const uint8_t SNAP_MAGIC = 'T';
+  const uint8_t SNAP_HEADER = 4;
+  int      snapStep = -1;   // -1 = idle
+  int      snapSteps = 0;
+  uint8_t  snapCount = 0;
+  uint16_t snapEpoch = 0;
+#ifdef REACTOR_TRACE_EEPROM
+  Record   staged[TRACE_SIZE];
+#endif
+
+  inline void push(uint8_t kind, uint8_t arg, uint16_t stamp) {
+    Record& r = ring[head];
+    if (count == TRACE_SIZE) {
+      // Overwriting the oldest record; keep its epoch if it carried one
+      if (r.kind == TR_EPOCH) tailEpoch = r.stamp;
+    } else {
+      ++count;
+    }
+    r.kind = kind;
+    r.arg = arg;
+    r.stamp = stamp;
+    head = (head + 1) & TRACE_MASK;
+  }
+
+  inline uint8_t oldestIndex() {
+    return (uint8_t)(head - count) & TRACE_MASK;
+  }
+
+  // Byte written at a given snapshot step: magic is cleared first and set last
+  void snapByte(int step, int& addr, uint8_t& value) {
+    const int base = ReactorEepromMap::TRACE_BASE;
+    int recordBytes = (int)snapCount * sizeof(Record);
+    if (step == 0) { addr = base; value = 0; return; }
+#ifdef REACTOR_TRACE_EEPROM
+    if (step <= recordBytes) {
+      int off = step - 1;
+      addr = base + SNAP_HEADER + off;
+      value = ((const uint8_t*)staged)[off];
+      return;
+    }
+#endif
+    switch (step - recordBytes) {
+      case 1:  addr = base + 1; value = snapCount; break;
+      case 2:  addr = base + 2; value = (uint8_t)snapEpoch; break;
+      case 3:  addr = base + 3; value = (uint8_t)(snapEpoch >> 8); break;
+      default: addr = base;     value = SNAP_MAGIC; break;
+    }
+  }
+
+  const __FlashStringHelper* kindName(uint8_t kind) {
+    switch (kind) {
+      case TR_BOOT:          return F("BOOT");
+      case TR_MODE:          return F("MODE");
+      case TR_BUTTON:        return F("BUTTON");
+      case TR_EVENT_TRIGGER: return F("EVENT+");
+      case TR_EVENT_RESOLVE: return F("EVENT-OK");
+      case TR_EVENT_FAIL:    return F("EVENT-FAIL");
+      case TR_SECRET:        return F("SECRET");
+      case TR_MUTE:          return F("MUTE");
+      case TR_HEAT:          return F("HEAT");
+      case TR_CHECK:         return F("CHECK");
+      default:               return F("?");
+    }
+  }
+
+  void printRecord(Print& out, uint16_t epoch, const Record& r) {
+    unsigned long ms = ((unsigned long)epoch << 16) | r.stamp;
+    out.print(ms);
+    out.print(' ');
+    out.print(kindName(r.kind));
+    out.print(' ');
+    if (r.kind == TR_BUTTON || r.kind == TR_SECRET || r.kind == TR_EVENT_TRIGGER ||
+        r.kind == TR_EVENT_RESOLVE || r.kind == TR_EVENT_FAIL) {
+      out.println((char)r.arg);
+    } else {
+      out.println(r.arg);
+    }
+  }
+}
+
+void begin() {
+  head = 0;
+  count = 0;
+  lastEpoch = 0;
+  tailEpoch = 0;
+  snapStep = -1;
+  record(TR_BOOT, 0);
+}
+
+void record(Kind kind, uint8_t arg) {
+  unsigned long now = millis();
+  uint16_t epoch = (uint16_t)(now >> 16);
+  if (epoch != lastEpoch) {
+    lastEpoch = epoch;
+    push(TR_EPOCH, 0, epoch);
+  }
+  push(kind, arg, (uint16_t)now);
+}
+
+void snapshotToEeprom() {
+#ifdef REACTOR_TRACE_EEPROM
+  if (snapStep >= 0) return;  // one snapshot at a time
+  uint8_t idx = oldestIndex();
+  for (uint8_t i = 0; i < count; ++i) staged[i] = ring[(idx + i) & TRACE_MASK];
+  snapCount = count;
+  snapEpoch = tailEpoch;
+  snapSteps = 1 + (int)snapCount * sizeof(Record) + 4;
+  snapStep = 0;
+#endif
+}
+
+void tick() {
+  if (snapStep < 0) return;
+  // One byte per loop, only when the EEPROM is idle, so the loop never stalls
+  if (!eeprom_is_ready()) return;
+  int addr;
+  uint8_t value;
+  snapByte(snapStep, addr, value);
+  EEPROM.update(addr, value);
+  if (++snapStep >= snapSteps) snapStep = -1;
+}
+
+void dump(Print& out) {
+  out.print(F("# trace "));
+  out.print(count);
+  out.print('/');
+  out.println(TRACE_SIZE);
+  uint16_t epoch = tailEpoch;
+  uint8_t idx = oldestIndex();
+  for (uint8_t i = 0; i < count; ++i) {
+    const Record& r = ring[(idx + i) & TRACE_MASK];
+    if (r.kind == TR_EPOCH) epoch = r.stamp;
+    else                    printRecord(out, epoch, r);
+  }
+}
+
+void dumpEeprom(Print& out) {
+  const int base = ReactorEepromMap::TRACE_BASE;
+  if (EEPROM.read(base) != SNAP_MAGIC) {
+    out.println(F("# no trace snapshot"));
+    return;
+  }
+  uint8_t n = EEPROM.read(base + 1);
+  if (n > TRACE_SIZE) n = TRACE_SIZE;
+  uint16_t epoch = EEPROM.read(base + 2) | ((uint16_t)EEPROM.read(base + 3) << 8);
+  out.print(F("# trace snapshot "));
+  out.println(n);
+  for (uint8_t i = 0; i < n; ++i) {
+    Record r;
+    EEPROM.get(base + SNAP_HEADER + i * sizeof(Record), r);
+    if (r.kind == TR_EPOCH) epoch = r.stamp;
+    else                    printRecord(out, epoch, r);
+  }
+}
+
+} // namespace ReactorTrace
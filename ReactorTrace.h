@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorTrace {
+
+// Record kinds; the meaning of the one-byte argument depends on the kind
+enum Kind : uint8_t {
+  TR_EPOCH,          // internal: stamp carries the high 16 bits of millis()
+  TR_BOOT,           // arg = 0
+  TR_MODE,           // arg = Mode entered
+  TR_BUTTON,         // arg = button code ('O','S','U','F','D','E','A')
+  TR_EVENT_TRIGGER,  // arg = required button code
+  TR_EVENT_RESOLVE,  // arg = required button code
+  TR_EVENT_FAIL,     // arg = required button code
+  TR_SECRET,         // arg = secret code ('G' god, 'C' chaos, 'Y' cryo)
+  TR_MUTE,           // arg = mute window in seconds (0 = window ended)
+  TR_HEAT,           // arg = heat band entered (0..4, level / 3)
+  TR_CHECK,          // arg = ReactorFuzz::Invariant that started failing
+  KIND_COUNT
+};
+
+void begin();
+
+// Constant-time append (4 bytes per record); safe to call from any tick path
+void record(Kind kind, uint8_t arg);
+
+// Call once per loop; advances an in-progress EEPROM snapshot by one byte
+void tick();
+
+// Start a non-blocking copy of the ring to EEPROM (no-op unless enabled)
+void snapshotToEeprom();
+
+// Human-readable dumps (slow; diagnostics only)
+void dump(Print& out);
+void dumpEeprom(Print& out);
+
+} // namespace ReactorTrace
@@ -0,0 +1,147 @@
+#include "ReactorTunables.h"
+#include "ReactorEepromMap.h"
+#include <EEPROM.h>
+#include <util/crc16.h>
+
+namespace ReactorTunables {
+
+uint16_t values[TUNABLE_COUNT];
+
+namespace {
+  struct Def {
+    const char* name;   // PROGMEM
+    uint16_t    def;
+    uint16_t    lo;
+    uint16_t    hi;
+  };
+
+  const char N_ARM[]      PROGMEM = "arm_step_ms";
+  const char N_CRIT[]     PROGMEM = "critical_ms";
+  const char N_MELT[]     PROGMEM = "meltdown_ms";
+  const char N_STAB[]     PROGMEM = "stab_step_ms";
+  const char N_STARTUP[]  PROGMEM = "startup_step_ms";
+  const char N_FREEZE[]   PROGMEM = "freeze_step_ms";
+  const char N_SHUTDOWN[] PROGMEM = "shutdown_step_ms";
+  const char N_EVENT[]    PROGMEM = "event_timeout_ms";
+  const char N_FRAME[]    PROGMEM = "ui_frame_ms";
+  const char N_ROD[]      PROGMEM = "rod_travel";
+  const char N_PUMP[]     PROGMEM = "pump_slew";
+  const char N_TELEM[]    PROGMEM = "telemetry_ms";
+  const char N_MIRROR[]   PROGMEM = "mirror_ms";
+
+  // Upper limits keep every derived mode window inside uint16_t
+  const Def DEFS[TUNABLE_COUNT] PROGMEM = {
+    { N_ARM,       500,  100,  6000 },
+    { N_CRIT,     3000,  500, 60000 },
+    { N_MELT,    10000, 1000, 60000 },
+    { N_STAB,     1000,  200, 12000 },
+    { N_STARTUP,  2000,  200, 12000 },
+    { N_FREEZE,   1200,  200, 12000 },
+    { N_SHUTDOWN, 2000,  200, 12000 },
+    { N_EVENT,    8000, 1000, 60000 },
+    { N_FRAME,     100,   20,  1000 },
+    { N_ROD,        16,    1,   255 },
+    { N_PUMP,        8,    1,   255 },
+    { N_TELEM,       0,    0, 60000 },
+    { N_MIRROR,      0,    0, 60000 },
+  };
+
+  // EEPROM block: magic, count, one word per id (0xFFFF = no override), CRC
+  const uint8_t  STORE_MAGIC = 'K';
+  const uint16_t NO_OVERRIDE = 0xFFFF;
+  const int      STORE_WORDS = ReactorEepromMap::TUNE_BASE + 2;
+  static_assert(2 + 2 * TUNABLE_COUNT + 2 <= ReactorEepromMap::TUNE_END - ReactorEepromMap::TUNE_BASE,
+                "tunables outgrew their EEPROM block");
+
+  inline uint16_t defOf(uint8_t i) { return pgm_read_word(&DEFS[i].def); }
+  inline uint16_t loOf(uint8_t i)  { return pgm_read_word(&DEFS[i].lo); }
+  inline uint16_t hiOf(uint8_t i)  { return pgm_read_word(&DEFS[i].hi); }
+  inline const __FlashStringHelper* nameOf(uint8_t i) {
+    return (const __FlashStringHelper*)pgm_read_ptr(&DEFS[i].name);
+  }
+
+  uint16_t storedWord(uint8_t i) {
+    uint16_t w;
+    return EEPROM.get(STORE_WORDS + 2 * i, w);
+  }
+
+  uint16_t storeCrc(uint8_t count) {
+    uint16_t crc = 0xFFFF;
+    for (int a = ReactorEepromMap::TUNE_BASE; a < STORE_WORDS + 2 * count; ++a) {
+      crc = _crc_ccitt_update(crc, EEPROM.read(a));
+    }
+    return crc;
+  }
+
+  // Rewrite the whole block from RAM (update() leaves unchanged bytes alone)
+  void store() {
+    EEPROM.update(ReactorEepromMap::TUNE_BASE, 0);   // invalid while rewriting
+    EEPROM.update(ReactorEepromMap::TUNE_BASE + 1, TUNABLE_COUNT);
+    for (uint8_t i = 0; i < TUNABLE_COUNT; ++i) {
+      EEPROM.put(STORE_WORDS + 2 * i, values[i] == defOf(i) ? NO_OVERRIDE : values[i]);
+    }
+    EEPROM.update(ReactorEepromMap::TUNE_BASE, STORE_MAGIC);
+    EEPROM.put(STORE_WORDS + 2 * TUNABLE_COUNT, storeCrc(TUNABLE_COUNT));
+  }
+}
+
+void begin() {
+  for (uint8_t i = 0; i < TUNABLE_COUNT; ++i) values[i] = defOf(i);
+
+  if (EEPROM.read(ReactorEepromMap::TUNE_BASE) != STORE_MAGIC) return;
+  // Older firmware stored fewer ids, newer firmware more: the CRC covers
+  // what was stored, and only the ids both know are applied
+  uint8_t count = EEPROM.read(ReactorEepromMap::TUNE_BASE + 1);
+  if (STORE_WORDS + 2 * count + 2 > ReactorEepromMap::TUNE_END) return;
+  uint16_t crc;
+  EEPROM.get(STORE_WORDS + 2 * count, crc);
+  if (crc != storeCrc(count)) return;
+  if (count > TUNABLE_COUNT) count = TUNABLE_COUNT;
+
+  for (uint8_t i = 0; i < count; ++i) {
+    uint16_t w = storedWord(i);
+    if (w != NO_OVERRIDE && w >= loOf(i) && w <= hiOf(i)) values[i] = w;
+  }
+}
+
+bool set(Id id, uint16_t v) {
+  if (id >= TUNABLE_COUNT || v < loOf(id) || v > hiOf(id)) return false;
+  values[id] = v;
+  store();
+  return true;
+}
+
+void restore(Id id) {
+  if (id >= TUNABLE_COUNT) return;
+  values[id] = defOf(id);
+  store();
+}
+
+bool find(const char* name, Id& id) {
+  for (uint8_t i = 0; i < TUNABLE_COUNT; ++i) {
+    if (strcmp_P(name, (const char*)pgm_read_ptr(&DEFS[i].name)) == 0) {
+      id = (Id)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void print(Print& out, Id id) {
+  out.print(nameOf(id));
+  out.print(' ');
+  out.print(values[id]);
+  out.print(' ');
+  out.print(defOf(id));
+  out.print(' ');
+  out.print(loOf(id));
+  out.print(F(".."));
+  out.println(hiOf(id));
+}
+
+void print(Print& out) {
+  out.println(F("# name value default min..max"));
+  for (uint8_t i = 0; i < TUNABLE_COUNT; ++i) print(out, (Id)i);
+}
+
+} // namespace ReactorTunables
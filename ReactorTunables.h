@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ReactorTunables {
+
+// Per-installation timing knobs. Defaults and limits live in flash; values
+// changed over Serial are stored in EEPROM and override the defaults at
+// boot. Append new ids at the end: stored overrides are matched by index.
+enum Id : uint8_t {
+  TN_ARM_STEP_MS,        // arming blink step; the ARMING window is 10 steps
+  TN_CRITICAL_MS,        // CRITICAL warning window
+  TN_MELTDOWN_MS,        // MELTDOWN countdown to CHAOS
+  TN_STAB_STEP_MS,       // stabilizing step; the sequence is 5 steps
+  TN_STARTUP_STEP_MS,    // startup step; 5 steps
+  TN_FREEZE_STEP_MS,     // freezedown step; 5 steps
+  TN_SHUTDOWN_STEP_MS,   // shutdown step; 5 steps
+  TN_EVENT_TIMEOUT_MS,   // base incident response time (scaled per type)
+  TN_UI_FRAME_MS,        // active-frame repaint period
+  TN_ROD_TRAVEL,         // control rod travel per core model step (of 255)
+  TN_PUMP_SLEW,          // coolant pump slew per core model step (of 255)
+  TN_TELEMETRY_MS,       // binary telemetry frame period (0 = off)
+  TN_MIRROR_MS,          // framebuffer mirror pass period (0 = off; -DREACTOR_MIRROR)
+  TUNABLE_COUNT
+};
+
+// RAM copy, read on the hot path through get()
+extern uint16_t values[TUNABLE_COUNT];
+
+inline uint16_t get(Id id) { return values[id]; }
+
+// Defaults, then any valid EEPROM overrides
+void begin();
+
+// Set one value (must be within its limits) and persist it; blocks on the
+// EEPROM for a few ms, so only call it from the console
+bool set(Id id, uint16_t v);
+
+// Drop the override and return to the flash default
+void restore(Id id);
+
+// Look up an id by its console name (case-sensitive)
+bool find(const char* name, Id& id);
+
+// "name value default min..max" per line, for all or for one
+void print(Print& out);
+void print(Print& out, Id id);
+
+} // namespace ReactorTunables
@@ -15,3 +15,5 @@ enum Mode : uint8_t {
   MODE_DARK,
   MODE_CHAOS
 };
+
+const uint8_t MODE_COUNT = MODE_CHAOS + 1;
@@ -1,5 +1,7 @@
 #include "ReactorUI.h"
 #include "ReactorAnimations.h"
+#include "ReactorDiag.h"
+#include "ReactorHeat.h"
 
 #include <Wire.h>
 #include <math.h>
@@ -10,6 +12,8 @@ namespace ReactorUI {
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 #define OLED_RESET -1
+#define OLED_ADDR 0x3C
+#define OLED_WIRE_MAX 32   // AVR Wire buffer (BUFFER_LENGTH)
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 
 // ---- Layout constants ----
@@ -83,7 +87,7 @@ static void uiTopBar(const char* modeLabel, const UIMetrics& m, bool muteActive)
   if (m.warning)    { uiDrawIcon(iconX, 1, GLYPH_WARN);    iconX -= 10; }
 }
 
-static void uiHeatBar(const UIMetrics& m) {
+void uiHeatBar(const UIMetrics& m) {
   const uint8_t topY  = UI_TOP_H + 4;
   const uint8_t h     = 8;
   const uint8_t leftX = 8;
@@ -190,24 +194,168 @@ static uint8_t breathHeatPercent(uint8_t basePercent, uint32_t nowMs) {
   return clampU8(breathed);
 }
 
+// ---- Heat trend ----
+// The graph owns framebuffer pages 4-5 (y 32..47) while shown. Each new
+// sample shifts those pages left and draws one column; any flush from
+// another path may have drawn over them, so it forces a full redraw.
+static const uint8_t TREND_PAGE0 = 4;
+static const uint8_t TREND_PAGES = 2;
+static const uint8_t TREND_TOP   = TREND_PAGE0 * 8;
+static const uint8_t TREND_H     = TREND_PAGES * 8;
+static const uint8_t TREND_W     = SCREEN_WIDTH;
+
+static bool     trendOn = false;
+static bool     trendValid = false;
+static bool     trendFlushing = false;
+static uint16_t trendDrawn = 0;     // ReactorHeat::historyCount() at last draw
+
+static uint8_t trendY(uint8_t sample) {
+  // 0..192 (1/16 level) -> bottom..top of the strip
+  return TREND_TOP + TREND_H - 1 - (uint16_t)sample * (TREND_H - 1) / 192;
+}
+
+static void trendColumn(uint8_t x, uint8_t age) {
+  uint8_t y = trendY(ReactorHeat::historyAt(age));
+  uint8_t yPrev = (age + 1 < ReactorHeat::historyCount()) ? trendY(ReactorHeat::historyAt(age + 1)) : y;
+  uint8_t top = min(y, yPrev);
+  display.drawFastVLine(x, top, max(y, yPrev) - top + 1, SSD1306_WHITE);
+}
+
+static void trendShift(uint8_t cols) {
+  uint8_t* buf = display.getBuffer();
+  for (uint8_t p = TREND_PAGE0; p < TREND_PAGE0 + TREND_PAGES; ++p) {
+    uint8_t* row = buf + (uint16_t)p * SCREEN_WIDTH;
+    memmove(row, row + cols, TREND_W - cols);
+    memset(row + TREND_W - cols, 0, cols);
+  }
+}
+
+static void uiTrend() {
+  uint16_t count = ReactorHeat::historyCount();
+  uint16_t fresh = count - trendDrawn;
+  if (!trendValid || fresh >= TREND_W) {
+    display.fillRect(0, TREND_TOP, TREND_W, TREND_H, SSD1306_BLACK);
+    uint8_t n = min((uint16_t)min(TREND_W, ReactorHeat::HISTORY_LEN), count);
+    for (uint8_t age = 0; age < n; ++age) trendColumn(TREND_W - 1 - age, age);
+    trendValid = true;
+  } else if (fresh) {
+    trendShift((uint8_t)fresh);
+    for (uint8_t age = 0; age < fresh; ++age) trendColumn(TREND_W - 1 - age, age);
+  }
+  trendDrawn = count;
+}
+
+void toggleTrend() {
+  trendOn = !trendOn;
+  trendValid = false;
+}
+
+void hideTrend() {
+  trendOn = false;
+}
+
+bool trendVisible() {
+  return trendOn;
+}
+
 // ---- Renderer ----
 Renderer ui;
 
+void flush() {
+  if (!trendFlushing) trendValid = false;
+  uint32_t c0 = ReactorDiag::cycles();
+  display.display();
+  ReactorDiag::addCycles(ReactorDiag::PROBE_FLUSH, ReactorDiag::cycles() - c0);
+  ReactorDiag::panelShown();
+}
+
+void flushPages(uint8_t pageMask) {
+  if (!trendFlushing) trendValid = false;
+  uint32_t c0 = ReactorDiag::cycles();
+  const uint8_t* buf = display.getBuffer();
+  uint8_t page = 0;
+  while (pageMask) {
+    // One address window per run of adjacent dirty pages
+    while (!(pageMask & 1)) { pageMask >>= 1; ++page; }
+    uint8_t first = page;
+    while (pageMask & 1) { pageMask >>= 1; ++page; }
+
+    display.ssd1306_command(SSD1306_PAGEADDR);
+    display.ssd1306_command(first);
+    display.ssd1306_command(page - 1);
+    display.ssd1306_command(SSD1306_COLUMNADDR);
+    display.ssd1306_command(0);
+    display.ssd1306_command(SCREEN_WIDTH - 1);
+
+    const uint8_t* p = buf + (uint16_t)first * SCREEN_WIDTH;
+    uint16_t left = (uint16_t)(page - first) * SCREEN_WIDTH;
+    while (left) {
+      // Control byte 0x40 (data stream) plus as much as the Wire buffer holds
+      uint8_t n = left < OLED_WIRE_MAX - 1 ? left : OLED_WIRE_MAX - 1;
+      Wire.beginTransmission(OLED_ADDR);
+      Wire.write((uint8_t)0x40);
+      Wire.write(p, n);
+      Wire.endTransmission();
+      p += n;
+      left -= n;
+    }
+  }
+  ReactorDiag::addCycles(ReactorDiag::PROBE_FLUSH, ReactorDiag::cycles() - c0);
+  ReactorDiag::panelShown();
+}
+
 bool begin() {
-  if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
     return false;
   }
   ReactorAnimations::begin();
   display.clearDisplay();
-  display.display();
+  flush();
   return true;
 }
 
+uint16_t litPixels() {
+  const uint8_t* buf = display.getBuffer();
+  uint16_t lit = 0;
+  for (uint16_t i = 0; i < (SCREEN_WIDTH * SCREEN_HEIGHT) / 8; ++i) {
+    uint8_t b = buf[i];
+    while (b) { b &= b - 1; ++lit; }
+  }
+  return lit;
+}
+
+// Plain (ASCII) PBM so a captured terminal log is directly viewable/diffable
+void dumpFramePBM(Print& out) {
+  const uint8_t* buf = display.getBuffer();
+  out.println(F("P1"));
+  out.print(F("# lit "));
+  out.println(litPixels());
+  out.print(SCREEN_WIDTH);
+  out.print(' ');
+  out.println(SCREEN_HEIGHT);
+  char row[SCREEN_WIDTH + 1];
+  row[SCREEN_WIDTH] = '\0';
+  for (uint8_t y = 0; y < SCREEN_HEIGHT; ++y) {
+    const uint8_t* page = buf + (y / 8) * SCREEN_WIDTH;
+    uint8_t mask = 1 << (y & 7);
+    for (uint8_t x = 0; x < SCREEN_WIDTH; ++x) row[x] = (page[x] & mask) ? '1' : '0';
+    out.println(row);
+  }
+}
+
 void Renderer::render(Mode mMode, const UIMetrics& m, bool muteActive) {
   const uint32_t now = millis();
   if (mMode == MODE_CHAOS) return;
 
-  display.clearDisplay();
+  // The trend strip survives between frames; everything else is redrawn
+  const bool trend = trendOn && mMode == MODE_STABLE;
+  if (trend && trendValid) {
+    display.fillRect(0, 0, SCREEN_WIDTH, TREND_TOP, SSD1306_BLACK);
+    display.fillRect(0, TREND_TOP + TREND_H, SCREEN_WIDTH, SCREEN_HEIGHT - TREND_TOP - TREND_H, SSD1306_BLACK);
+  } else {
+    display.clearDisplay();
+    trendValid = false;
+  }
 
   switch (mMode) {
     case MODE_STABLE:      uiTopBar("STABLE",      m, muteActive); break;
@@ -228,13 +376,17 @@ void Renderer::render(Mode mMode, const UIMetrics& m, bool muteActive) {
 
   switch (mMode) {
     case MODE_STABLE: {
-      // Draw reactor core centerpiece with decay particles
-      ReactorAnimations::drawReactorCore(display, now, m.heatPercent);
-      ReactorAnimations::drawDecayParticles(display, now);
+      if (trend) {
+        uiTrend();
+      } else {
+        // Draw reactor core centerpiece with decay particles
+        ReactorAnimations::drawReactorCore(display, now, m.heatPercent);
+        ReactorAnimations::drawDecayParticles(display, now);
+      }
       uiStableStatusText();
       if (((now/750) % 2) == 0) uiDrawIcon(4, UI_TOP_H + 2, GLYPH_POWER);
-      // Add subtle Geiger clicks
-      ReactorAnimations::drawGeigerFlashes(display, now, m.heatPercent / 5);
+      // Add subtle Geiger clicks (they would smear into the kept trend strip)
+      if (!trend) ReactorAnimations::drawGeigerFlashes(display, now, m.heatPercent / 5);
     } break;
 
     case MODE_ARMING: {
@@ -321,7 +473,9 @@ void Renderer::render(Mode mMode, const UIMetrics& m, bool muteActive) {
   // Optional: add subtle scan lines for retro effect (can disable if too intense)
   // ReactorAnimations::drawScanLines(display, now);
 
-  display.display();
+  trendFlushing = trend;
+  flush();
+  trendFlushing = false;
 }
 
 } // namespace ReactorUI
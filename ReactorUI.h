@@ -25,6 +25,26 @@ public:
 
 // Accessors
 bool begin();
+
+// Heat bar strip under the header; drawn by render(), exposed for ReactorBench
+void uiHeatBar(const UIMetrics& m);
+
+// Push the framebuffer to the panel (all display.display() calls go through here)
+void flush();
+
+// Push only the 8-row pages whose bit is set in pageMask (bit 0 = rows 0..7);
+// for paths that edit the framebuffer directly and know what they touched
+void flushPages(uint8_t pageMask);
+
+// Heat trend sparkline in place of the STABLE core animation
+void toggleTrend();
+void hideTrend();
+bool trendVisible();
+
+// Framebuffer inspection (diagnostics; reads the buffer, not the panel)
+uint16_t litPixels();
+void dumpFramePBM(Print& out);
+
 extern Renderer ui;
 extern Adafruit_SSD1306 display;
 
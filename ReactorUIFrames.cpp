@@ -38,7 +38,7 @@ void drawCenteredBig(const char* txt, uint8_t size) {
   int16_t y = ((int16_t)ReactorUI::display.height() - (int16_t)h) / 2;
   ReactorUI::display.setCursor(x, y);
   ReactorUI::display.print(txt);
-  ReactorUI::display.display();
+  ReactorUI::flush();
 }
 
 void drawPowerOnSplash() {
@@ -68,7 +68,7 @@ void drawPowerOnSplash() {
   ReactorUI::display.setCursor(x, 54);
   ReactorUI::display.print("INITIALIZING");
   
-  ReactorUI::display.display();
+  ReactorUI::flush();
   
   // Play the Final Countdown theme (blocking, but we show static screen)
   ReactorAudio::playFinalCountdown();
@@ -116,16 +116,24 @@ void renderActiveUIFrame(Mode mode, unsigned long meltdownStartAt) {
         ReactorUI::display.setCursor(10, 42);
         ReactorUI::display.print("PRESS ");
         ReactorUI::display.println(ReactorEvents::getRequiredButtonName());
+
+        // Further incidents queued behind the one shown
+        uint8_t more = ReactorEvents::activeCount() - 1;
+        if (more) {
+          ReactorUI::display.setCursor(w - 22, 31);
+          ReactorUI::display.print('+');
+          ReactorUI::display.print(more);
+        }
         
-        ReactorUI::display.display();
+        ReactorUI::flush();
       }
       break;
 
     case MODE_ARMING: {
-      // Display 5-second countdown
+      // Display the arming countdown
       unsigned long now = millis();
       unsigned long elapsed = now - ReactorStateMachine::armingStartAt;
-      long remaining = 5000 - (long)elapsed;
+      long remaining = (long)ReactorStateMachine::timeoutMs(MODE_ARMING) - (long)elapsed;
       if (remaining < 0) remaining = 0;
       
       int seconds = (remaining + 999) / 1000;  // Ceiling division to round up
@@ -153,10 +161,10 @@ void renderActiveUIFrame(Mode mode, unsigned long meltdownStartAt) {
     } break;
 
     case MODE_CRITICAL: {
-      // Display 3-second critical warning with intense effects
+      // Display the critical warning countdown with intense effects
       unsigned long now = millis();
       unsigned long elapsed = now - ReactorStateMachine::criticalStartAt;
-      long remaining = 3000 - (long)elapsed;
+      long remaining = (long)ReactorStateMachine::timeoutMs(MODE_CRITICAL) - (long)elapsed;
       if (remaining < 0) remaining = 0;
       
       int seconds = (remaining + 999) / 1000;  // Ceiling division to round up
@@ -221,7 +229,7 @@ void renderActiveUIFrame(Mode mode, unsigned long meltdownStartAt) {
       ReactorAnimations::drawCornerBrackets(ReactorUI::display, 4);
       ReactorAnimations::drawGeigerFlashes(ReactorUI::display, now, 95);
       
-      ReactorUI::display.display();
+      ReactorUI::flush();
     } break;
 
     case MODE_STARTUP: {
@@ -256,7 +264,7 @@ void renderActiveUIFrame(Mode mode, unsigned long meltdownStartAt) {
     case MODE_MELTDOWN: {
       unsigned long now = millis();
       unsigned long meltdownElapsed = (now >= meltdownStartAt) ? (now - meltdownStartAt) : 0;
-      long remain = 10000L - (long)meltdownElapsed;  // 10 second countdown
+      long remain = (long)ReactorStateMachine::timeoutMs(MODE_MELTDOWN) - (long)meltdownElapsed;
       if (remain < 0) remain = 0;
       
       int seconds = (remain + 999) / 1000;  // Ceiling division to round up
@@ -307,7 +315,7 @@ void renderActiveUIFrame(Mode mode, unsigned long meltdownStartAt) {
       ReactorAnimations::drawPulsingBorder(ReactorUI::display, now, 100);
       ReactorAnimations::drawGeigerFlashes(ReactorUI::display, now, 90);
       
-      ReactorUI::display.display();
+      ReactorUI::flush();
     } break;
 
     case MODE_CHAOS:
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Operator.h"
+
+namespace Operator {
+
+namespace {
+  const char    CODES[] = "OSUFDEA";
+  const uint8_t PINS[]  = { 2, 5, 10, 8, 6, 3, 4 };
+
+  std::vector<Press> presses;
+  std::vector<Line>  lines;
+  size_t             nextLine = 0;
+
+  bool heldAt(int pin, uint64_t t) {
+    for (const Press& p : presses) {
+      if (pinOf(p.code) == pin && t >= p.atUs && t < p.atUs + p.holdUs) return true;
+    }
+    return false;
+  }
+
+  // Next wall time after now at which an armed pin changes level
+  bool nextWakeEdge(uint64_t now, uint64_t& at) {
+    bool found = false;
+    for (const Press& p : presses) {
+      int pin = pinOf(p.code);
+      if (!Host::wakeArmed((uint8_t)pin)) continue;
+      const uint64_t edges[2] = { p.atUs, p.atUs + p.holdUs };
+      for (uint64_t e : edges) {
+        if (e > now && (!found || e < at)) { at = e; found = true; }
+      }
+    }
+    return found;
+  }
+
+  bool onSleep() {
+    uint64_t at = 0;
+    if (!nextWakeEdge(Host::wallUs(), at)) return false;
+    Host::advanceAsleepUs(at - Host::wallUs());
+    apply();
+    return true;
+  }
+}
+
+int pinOf(char code) {
+  const char* c = strchr(CODES, code);
+  return c && *c ? PINS[c - CODES] : -1;
+}
+
+bool parsePresses(const char* spec, std::vector<Press>& out) {
+  while (spec && *spec) {
+    char* end;
+    unsigned long ms = strtoul(spec, &end, 10);
+    if (*end != ':' || pinOf(end[1]) < 0) return false;
+    Press p = { ms * 1000ULL, 150000ULL, end[1] };
+    spec = end + 2;
+    if (*spec == ':') {
+      p.holdUs = strtoul(spec + 1, &end, 10) * 1000ULL;
+      spec = end;
+    }
+    out.push_back(p);
+    if (*spec == ',') ++spec;
+    else if (*spec) return false;
+  }
+  return true;
+}
+
+void setPresses(const std::vector<Press>& p) {
+  presses = p;
+}
+
+void addLine(uint64_t atUs, const std::string& text) {
+  lines.push_back({ atUs, text });
+  std::stable_sort(lines.begin(), lines.end(),
+                   [](const Line& a, const Line& b) { return a.atUs < b.atUs; });
+}
+
+void apply() {
+  uint64_t now = Host::wallUs();
+  for (uint8_t i = 0; i < sizeof(PINS); ++i) {
+    Host::setInput(PINS[i], !heldAt(PINS[i], now));
+  }
+  while (nextLine < lines.size() && lines[nextLine].atUs <= now) {
+    Host::serialInput(lines[nextLine++].text);
+  }
+}
+
+void install() {
+  Host::setSleepHandler(onSleep);
+}
+
+} // namespace Operator
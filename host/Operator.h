@@ -0,0 +1,40 @@
+#pragma once
+
+// Scripted operator for host runs: button holds and Serial lines on the wall
+// clock, applied to the pins before every loop pass. Also the sleep handler
+// that wakes MODE_DARK on the next scripted change of a wake-armed pin.
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "hal/Host.h"
+
+namespace Operator {
+
+struct Press {
+  uint64_t atUs;
+  uint64_t holdUs;
+  char     code;     // 'O','S','U','F','D','E','A'
+};
+
+struct Line {
+  uint64_t    atUs;
+  std::string text;
+};
+
+// Board pin of a button code (as wired in ReactorButtons.cpp); -1 if unknown
+int pinOf(char code);
+
+// "MS:B[:HOLD],..." (HOLD ms, default 150). Returns false on a bad entry.
+bool parsePresses(const char* spec, std::vector<Press>& out);
+
+void setPresses(const std::vector<Press>& presses);
+void addLine(uint64_t atUs, const std::string& text);
+
+// Drive every button pin and feed due Serial lines for the current wall time
+void apply();
+
+// Installs itself with Host::setSleepHandler
+void install();
+
+} // namespace Operator
@@ -0,0 +1,271 @@
+// reactor_fuzz: random operators against the unmodified sketch in virtual time.
+//
+//   reactor_fuzz [-j N] [--loops N] [--seed S] [--step US]
+//
+// Forks N workers (default: one per CPU). Worker i seeds its operator and the
+// sketch (through A0) with S + i, then runs --loops / N loop() passes. The
+// operator works on the pins, so every press goes through the debouncer: taps,
+// secret-sized bursts, long holds, contact bounce, and ACK held with EVENT or
+// STABILIZE pressed under it (the chords). ReactorFuzz's invariants (built in
+// with -DREACTOR_CHECKS) are read after every pass; each new failure prints with its seed and virtual time, and
+// a single worker with that seed and the same --loops / N replays it exactly.
+// Exits 1 if any invariant failed.
+
+#include <chrono>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Operator.h"
+#include "../ReactorFuzz.h"
+#include "../ReactorStateMachine.h"
+
+#ifndef REACTOR_CHECKS
+#error "reactor_fuzz reads ReactorFuzz's invariants; build it with -DREACTOR_CHECKS"
+#endif
+
+void setup();
+void loop();
+
+namespace {
+  const char* const INVARIANTS[ReactorFuzz::INV_COUNT] = {
+    "status_leds", "muted_silent", "mode_timeout", "timed_exit"
+  };
+
+  struct Result {
+    uint64_t loops;
+    uint64_t wallUs;
+    uint32_t presses;
+    uint32_t chords;
+    uint32_t failures[ReactorFuzz::INV_COUNT];
+    uint32_t worstPassUs[MODE_COUNT];
+  };
+
+  // One pin level change on the wall clock
+  struct Change {
+    uint64_t atUs;
+    uint8_t  pin;
+    bool     level;
+    bool operator>(const Change& o) const { return atUs > o.atUs; }
+  };
+
+  // Random operator: gestures at random gaps, queued as pin changes
+  class Fuzzer {
+  public:
+    explicit Fuzzer(uint32_t seed) : rng(seed) {
+      const char* codes = "OSUFDEA";
+      for (uint8_t i = 0; i < 7; ++i) pins[i] = (uint8_t)Operator::pinOf(codes[i]);
+    }
+
+    // Make sure every change up to t is queued, then apply the due ones
+    void apply(uint64_t now) {
+      while (nextGestureAt <= now + 1000000) gesture();
+      while (!queue.empty() && queue.top().atUs <= now) {
+        Host::setInput(queue.top().pin, queue.top().level);
+        queue.pop();
+      }
+    }
+
+    // Sleep: skip ahead to the next change on a wake-armed pin
+    bool wake() {
+      for (;;) {
+        if (queue.empty()) gesture();
+        Change c = queue.top();
+        queue.pop();
+        if (c.atUs > Host::wallUs()) Host::advanceAsleepUs(c.atUs - Host::wallUs());
+        Host::setInput(c.pin, c.level);
+        if (Host::wakeArmed(c.pin)) return true;
+      }
+    }
+
+    uint32_t presses = 0;
+    uint32_t chords = 0;
+
+  private:
+    std::mt19937       rng;
+    uint8_t            pins[7];   // O S U F D E A
+    uint64_t           nextGestureAt = 0;
+    uint64_t           freeAt[7] = {};
+    std::priority_queue<Change, std::vector<Change>, std::greater<Change> > queue;
+
+    uint32_t between(uint32_t lo, uint32_t hi) {
+      return std::uniform_int_distribution<uint32_t>(lo, hi)(rng);
+    }
+
+    // Press button b at (or after its last release) for holdMs; returns the
+    // press time. Contact bounce adds a few short toggles first.
+    uint64_t press(uint8_t b, uint64_t atUs, uint32_t holdMs, bool bounce = false) {
+      if (atUs < freeAt[b]) atUs = freeAt[b] + 20000;
+      uint64_t t = atUs;
+      if (bounce) {
+        for (uint8_t i = between(2, 6); i > 0; --i) {
+          queue.push({ t, pins[b], LOW });
+          t += between(200, 8000);
+          queue.push({ t, pins[b], HIGH });
+          t += between(200, 8000);
+        }
+      }
+      queue.push({ t, pins[b], LOW });
+      t += holdMs * 1000ULL;
+      queue.push({ t, pins[b], HIGH });
+      freeAt[b] = t;
+      ++presses;
+      return atUs;
+    }
+
+    void gesture() {
+      uint64_t t = nextGestureAt;
+      uint32_t kind = between(0, 99);
+      if (kind < 50) {
+        press(between(0, 5), t, between(60, 400));
+      } else if (kind < 62) {
+        // Secret-sized burst
+        for (uint8_t i = between(4, 7); i > 0; --i) {
+          press(between(0, 5), t, between(60, 200));
+          t += between(120, 600) * 1000ULL;
+        }
+      } else if (kind < 74) {
+        press(6, t, between(60, 400));
+      } else if (kind < 90) {
+        // ACK held, EVENT or STABILIZE pressed under it
+        uint32_t holdMs = between(300, 1500);
+        uint64_t at = press(6, t, holdMs);
+        press(between(0, 1) ? 5 : 1, at + between(60, holdMs - 150) * 1000ULL, between(60, 150));
+        ++chords;
+      } else if (kind < 95) {
+        press(between(0, 6), t, between(60, 400), true);
+      } else {
+        press(between(0, 6), t, between(2000, 8000));
+      }
+      nextGestureAt = t + between(kind < 62 ? 150 : 400, 6000) * 1000ULL;
+    }
+  };
+
+  Fuzzer* fuzzer = 0;
+
+  bool onSleep() {
+    return fuzzer->wake();
+  }
+
+  Result work(uint32_t seed, uint64_t loops, uint32_t stepUs) {
+    Result r = {};
+    Fuzzer f(seed);
+    fuzzer = &f;
+    Host::setSleepHandler(onSleep);
+    Host::setAnalog(A0, seed & 0x3FF);
+    Host::setBaud(0);
+
+    f.apply(Host::wallUs());
+    setup();
+
+    uint16_t seen[ReactorFuzz::INV_COUNT] = {};
+    for (r.loops = 0; r.loops < loops; ++r.loops) {
+      f.apply(Host::wallUs());
+      uint64_t start = Host::nowUs();
+      loop();
+      uint32_t took = (uint32_t)(Host::nowUs() - start);
+      Mode m = ReactorStateMachine::getMode();
+      if (took > r.worstPassUs[m]) r.worstPassUs[m] = took;
+      for (uint8_t i = 0; i < ReactorFuzz::INV_COUNT; ++i) {
+        uint16_t n = ReactorFuzz::failures((ReactorFuzz::Invariant)i);
+        if (n == seen[i]) continue;
+        seen[i] = n;
+        ++r.failures[i];
+        fprintf(stderr, "seed %u  %12.3f  %-11s %s\n", seed, Host::wallUs() / 1000.0,
+                (const char*)ReactorStateMachine::modeName(m), INVARIANTS[i]);
+      }
+      Host::takeSerialOutput();
+      Host::advanceUs(stepUs);
+    }
+    r.wallUs = Host::wallUs();
+    r.presses = f.presses;
+    r.chords = f.chords;
+    return r;
+  }
+
+  int usage() {
+    fprintf(stderr, "usage: reactor_fuzz [-j N] [--loops N] [--seed S] [--step US]\n");
+    return 2;
+  }
+}
+
+int main(int argc, char** argv) {
+  long     jobs = sysconf(_SC_NPROCESSORS_ONLN);
+  uint64_t loops = 10000000;
+  uint32_t seed = 1;
+  uint32_t stepUs = 500;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    bool more = i + 1 < argc;
+    if (a == "-j" && more)           jobs = strtol(argv[++i], 0, 10);
+    else if (a == "--loops" && more) loops = strtoull(argv[++i], 0, 10);
+    else if (a == "--seed" && more)  seed = strtoul(argv[++i], 0, 10);
+    else if (a == "--step" && more)  stepUs = strtoul(argv[++i], 0, 10);
+    else return usage();
+  }
+  if (jobs < 1) jobs = 1;
+
+  // The sketch is one set of globals, so each worker is its own process
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<pid_t> pids;
+  std::vector<int>   fds;
+  for (long j = 0; j < jobs; ++j) {
+    int fd[2];
+    if (pipe(fd) < 0) { perror("pipe"); return 1; }
+    pid_t pid = fork();
+    if (pid < 0) { perror("fork"); return 1; }
+    if (pid == 0) {
+      close(fd[0]);
+      Result r = work(seed + (uint32_t)j, loops / jobs, stepUs);
+      ssize_t n = write(fd[1], &r, sizeof(r));
+      _exit(n == (ssize_t)sizeof(r) ? 0 : 1);
+    }
+    close(fd[1]);
+    pids.push_back(pid);
+    fds.push_back(fd[0]);
+  }
+
+  Result total = {};
+  int    lost = 0;
+  for (size_t j = 0; j < pids.size(); ++j) {
+    Result r;
+    bool ok = read(fds[j], &r, sizeof(r)) == (ssize_t)sizeof(r);
+    close(fds[j]);
+    int status = 0;
+    waitpid(pids[j], &status, 0);
+    if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      fprintf(stderr, "seed %u  worker died (status %d)\n", seed + (uint32_t)j, status);
+      ++lost;
+      continue;
+    }
+    total.loops += r.loops;
+    total.wallUs += r.wallUs;
+    total.presses += r.presses;
+    total.chords += r.chords;
+    for (uint8_t i = 0; i < ReactorFuzz::INV_COUNT; ++i) total.failures[i] += r.failures[i];
+    for (uint8_t i = 0; i < MODE_COUNT; ++i) {
+      if (r.worstPassUs[i] > total.worstPassUs[i]) total.worstPassUs[i] = r.worstPassUs[i];
+    }
+  }
+  double hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  fprintf(stderr, "# mode worst_pass_us (virtual time, step excluded)\n");
+  for (uint8_t i = 0; i < MODE_COUNT; ++i) {
+    if (total.worstPassUs[i]) fprintf(stderr, "%s %u\n", (const char*)ReactorStateMachine::modeName(i), total.worstPassUs[i]);
+  }
+  fprintf(stderr, "# invariant failures\n");
+  unsigned long failed = 0;
+  for (uint8_t i = 0; i < ReactorFuzz::INV_COUNT; ++i) {
+    fprintf(stderr, "%s %u\n", INVARIANTS[i], total.failures[i]);
+    failed += total.failures[i];
+  }
+  fprintf(stderr, "workers %ld (seeds %u..%u)\n", jobs, seed, seed + (uint32_t)jobs - 1);
+  fprintf(stderr, "loops %llu\n", (unsigned long long)total.loops);
+  fprintf(stderr, "presses %u, ACK chords %u\n", total.presses, total.chords);
+  fprintf(stderr, "virtual s %.0f\n", total.wallUs / 1e6);
+  fprintf(stderr, "host s %.3f (%.0f loops/s)\n", hostSec, hostSec > 0 ? total.loops / hostSec : 0.0);
+  return failed || lost ? 1 : 0;
+}
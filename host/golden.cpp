@@ -0,0 +1,269 @@
+// reactor_golden: every renderer path at a fixed virtual time, against
+// checked-in golden frames.
+//
+//   reactor_golden [--update] [--dir DIR] [--out DIR]
+//
+// Each case draws one frame through ReactorUI::Renderer::render() or a
+// ReactorUIFrames::renderActiveUIFrame() branch. The clock is at the case's
+// timestamp, the RNG is seeded and the particles are reset, so the frame only
+// changes when the drawing code does. Frames are compared with DIR/<case>.pbm
+// (default golden/). A mismatch reports the pixel count and bounding box and
+// writes <case>.pbm and <case>.diff.pbm (differing pixels set) to --out
+// (default golden_out/). --update rewrites the goldens instead.
+//
+// Every case also prints lit pixels, GFX calls, pixel writes, distinct pixels
+// written and overdraw (writes per distinct pixel) for that frame alone.
+// Glyphs are the host HAL's placeholders, so text shows position and width only.
+// Exits 1 on any mismatch or missing golden.
+
+#include <string>
+#include <sys/stat.h>
+#include "hal/Host.h"
+#include "../ReactorUI.h"
+#include "../ReactorUIFrames.h"
+#include "../ReactorAnimations.h"
+#include "../ReactorAudio.h"
+#include "../ReactorEvents.h"
+#include "../ReactorHeat.h"
+#include "../ReactorHeatControl.h"
+#include "../ReactorRandom.h"
+#include "../ReactorSequences.h"
+#include "../ReactorStateMachine.h"
+
+void setup();
+
+namespace {
+  const uint16_t GOLDEN_SEED = 0x5EED;   // same as ReactorBench
+  const uint8_t  HEAT_PERCENT = 45;
+
+  typedef void (*DrawFn)(uint32_t atMs);
+
+  struct Case {
+    const char* name;
+    uint32_t    atMs;    // virtual time of the frame; cases run in this order
+    DrawFn      draw;
+  };
+
+  Adafruit_SSD1306& gfx() { return ReactorUI::display; }
+
+  void at(uint32_t ms) {
+    uint64_t target = (uint64_t)ms * 1000;
+    if (Host::nowUs() < target) Host::advanceUs((uint32_t)(target - Host::nowUs()));
+  }
+
+  // Same starting point for every case: STABLE, no incident, unmuted, trend
+  // off, heat at HEAT_PERCENT
+  void fresh(uint32_t ms) {
+    at(ms);
+    ReactorStateMachine::force(MODE_STABLE);
+    ReactorEvents::begin();
+    ReactorAudio::unmute();
+    ReactorUI::hideTrend();
+    ReactorHeat::setLevelQ8((uint16_t)(12 * 256) * HEAT_PERCENT / 100);
+  }
+
+  // Seed and reset particles last, so set-up work doesn't shift the draws
+  void seed() {
+    randomSeed(GOLDEN_SEED);
+    ReactorRandom::seed(GOLDEN_SEED);
+    ReactorAnimations::resetParticles();
+  }
+
+  // ---- Renderer::render(), fixed metrics ----
+  void render(uint32_t atMs, Mode mode, bool muted) {
+    fresh(atMs);
+    seed();
+    ReactorUI::UIMetrics m;
+    m.heatPercent = HEAT_PERCENT;
+    m.countdownMs = 7300;
+    m.progress    = 60;
+    m.freezing    = mode == MODE_FREEZEDOWN;
+    Host::resetDrawCounts(gfx());
+    ReactorUI::ui.render(mode, m, muted);
+  }
+
+  // The trend strip needs a minute of heat history behind it
+  void renderTrend(uint32_t atMs) {
+    fresh(atMs - 60000);
+    ReactorUI::toggleTrend();
+    while (Host::nowUs() < (uint64_t)atMs * 1000) {
+      Host::advanceUs(40000);
+      ReactorHeatControl::tick(MODE_STABLE);
+    }
+    ReactorHeat::setLevelQ8((uint16_t)(12 * 256) * HEAT_PERCENT / 100);
+    seed();
+    ReactorUI::UIMetrics m;
+    m.heatPercent = HEAT_PERCENT;
+    Host::resetDrawCounts(gfx());
+    ReactorUI::ui.render(MODE_STABLE, m, false);
+  }
+
+  // ---- renderActiveUIFrame(): enter the mode leadMs before the frame and run
+  // its sequence in 10 ms steps, as the loop would ----
+  void frame(uint32_t atMs, Mode mode, uint32_t leadMs) {
+    fresh(atMs - leadMs);
+    ReactorStateMachine::force(mode);
+    while (Host::nowUs() + 10000 <= (uint64_t)atMs * 1000) {
+      Host::advanceUs(10000);
+      ReactorSequences::tick(mode);
+    }
+    at(atMs);
+    ReactorHeat::setLevelQ8((uint16_t)(12 * 256) * HEAT_PERCENT / 100);
+    seed();
+    Host::resetDrawCounts(gfx());
+    ReactorUIFrames::renderActiveUIFrame(mode, ReactorStateMachine::meltdownStartAt);
+  }
+
+  void frameIncident(uint32_t atMs) {
+    fresh(atMs - 1000);
+    seed();
+    ReactorEvents::trigger("leak");
+    at(atMs);
+    seed();
+    Host::resetDrawCounts(gfx());
+    ReactorUIFrames::renderActiveUIFrame(MODE_STABLE, ReactorStateMachine::meltdownStartAt);
+  }
+
+  // CRITICAL flashes on a 200 ms cycle: on at even multiples
+  const Case CASES[] = {
+    { "render_stable",        100000, [](uint32_t t) { render(t, MODE_STABLE, false); } },
+    { "render_stable_muted",  200000, [](uint32_t t) { render(t, MODE_STABLE, true); } },
+    { "render_stable_trend",  300000, renderTrend },
+    { "render_arming",        400000, [](uint32_t t) { render(t, MODE_ARMING, false); } },
+    { "render_meltdown",      500000, [](uint32_t t) { render(t, MODE_MELTDOWN, false); } },
+    { "render_stabilizing",   600000, [](uint32_t t) { render(t, MODE_STABILIZING, false); } },
+    { "render_startup",       700000, [](uint32_t t) { render(t, MODE_STARTUP, false); } },
+    { "render_freezedown",    800000, [](uint32_t t) { render(t, MODE_FREEZEDOWN, false); } },
+    { "render_shutdown",      900000, [](uint32_t t) { render(t, MODE_SHUTDOWN, false); } },
+    { "render_dark",         1000000, [](uint32_t t) { render(t, MODE_DARK, false); } },
+    { "frame_stable",        1100000, [](uint32_t t) { frame(t, MODE_STABLE, 1000); } },
+    { "frame_incident",      1200000, frameIncident },
+    { "frame_arming",        1300000, [](uint32_t t) { frame(t, MODE_ARMING, 2500); } },
+    { "frame_critical_on",   1400000, [](uint32_t t) { frame(t, MODE_CRITICAL, 1000); } },
+    { "frame_critical_off",  1500200, [](uint32_t t) { frame(t, MODE_CRITICAL, 1000); } },
+    { "frame_meltdown",      1600000, [](uint32_t t) { frame(t, MODE_MELTDOWN, 3000); } },
+    { "frame_startup",       1700000, [](uint32_t t) { frame(t, MODE_STARTUP, 3000); } },
+    { "frame_stabilizing",   1800000, [](uint32_t t) { frame(t, MODE_STABILIZING, 3000); } },
+    { "frame_freezedown",    1900000, [](uint32_t t) { frame(t, MODE_FREEZEDOWN, 3000); } },
+    { "frame_shutdown",      2000000, [](uint32_t t) { frame(t, MODE_SHUTDOWN, 3000); } },
+  };
+
+  bool pixel(const uint8_t* buf, int x, int y) {
+    return buf[(y / 8) * 128 + x] & (1 << (y & 7));
+  }
+
+  unsigned lit(const uint8_t* buf) {
+    unsigned n = 0;
+    for (int i = 0; i < 1024; ++i) n += __builtin_popcount(buf[i]);
+    return n;
+  }
+
+  // P4 as written by Host::writePbm, back into the panel's page layout
+  bool readPbm(const std::string& path, uint8_t* buf) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char magic[3] = {};
+    int w = 0, h = 0;
+    bool ok = fscanf(f, "%2s %d %d", magic, &w, &h) == 3 && fgetc(f) != EOF
+           && std::string(magic) == "P4" && w == 128 && h == 64;
+    memset(buf, 0, 1024);
+    for (int y = 0; ok && y < 64; ++y) {
+      for (int xb = 0; xb < 16; ++xb) {
+        int c = fgetc(f);
+        if (c == EOF) { ok = false; break; }
+        for (int b = 0; b < 8; ++b) {
+          if (c & (0x80 >> b)) buf[(y / 8) * 128 + xb * 8 + b] |= 1 << (y & 7);
+        }
+      }
+    }
+    fclose(f);
+    return ok;
+  }
+
+  bool writePbm(const std::string& path, const uint8_t* buf) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) { perror(path.c_str()); return false; }
+    Host::writePbm(f, buf);
+    fclose(f);
+    return true;
+  }
+
+  int usage() {
+    fprintf(stderr, "usage: reactor_golden [--update] [--dir DIR] [--out DIR]\n");
+    return 2;
+  }
+}
+
+int main(int argc, char** argv) {
+  bool        update = false;
+  std::string dir = "golden";
+  std::string out = "golden_out";
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    bool more = i + 1 < argc;
+    if (a == "--update")            update = true;
+    else if (a == "--dir" && more)  dir = argv[++i];
+    else if (a == "--out" && more)  out = argv[++i];
+    else return usage();
+  }
+
+  setup();
+
+  int failed = 0;
+  printf("%-20s %5s %5s %6s %6s %8s\n", "case", "lit", "calls", "writes", "pixels", "overdraw");
+  for (const Case& c : CASES) {
+    if (Host::nowUs() >= (uint64_t)c.atMs * 1000) {
+      fprintf(stderr, "%s: clock already past %u ms\n", c.name, c.atMs);
+      return 1;
+    }
+    c.draw(c.atMs);
+
+    const uint8_t* buf = gfx().getBuffer();
+    Host::DrawCounts n = Host::drawCounts(gfx());
+    printf("%-20s %5u %5lu %6lu %6lu %8.2f", c.name, ReactorUI::litPixels(), n.calls,
+           n.writes, n.pixels, n.pixels ? (double)n.writes / n.pixels : 0.0);
+
+    std::string golden = dir + "/" + c.name + ".pbm";
+    if (update) {
+      if (!writePbm(golden, buf)) return 1;
+      printf("  updated\n");
+      continue;
+    }
+
+    uint8_t want[1024];
+    if (!readPbm(golden, want)) {
+      printf("  MISSING %s\n", golden.c_str());
+      ++failed;
+      continue;
+    }
+
+    uint8_t diff[1024];
+    unsigned bad = 0;
+    int x0 = 128, y0 = 64, x1 = -1, y1 = -1;
+    for (int i = 0; i < 1024; ++i) diff[i] = buf[i] ^ want[i];
+    for (int y = 0; y < 64; ++y) {
+      for (int x = 0; x < 128; ++x) {
+        if (!pixel(diff, x, y)) continue;
+        ++bad;
+        if (x < x0) x0 = x;
+        if (y < y0) y0 = y;
+        if (x > x1) x1 = x;
+        if (y > y1) y1 = y;
+      }
+    }
+    if (!bad) {
+      printf("  ok\n");
+      continue;
+    }
+    ++failed;
+    mkdir(out.c_str(), 0777);
+    writePbm(out + "/" + c.name + ".pbm", buf);
+    writePbm(out + "/" + c.name + ".diff.pbm", diff);
+    printf("  DIFF %u px in (%d,%d)-(%d,%d), golden lit %u -> %s/%s.diff.pbm\n",
+           bad, x0, y0, x1, y1, lit(want), out.c_str(), c.name);
+  }
+
+  if (failed) fprintf(stderr, "%d of %u frames differ from %s/\n", failed, (unsigned)(sizeof(CASES) / sizeof(CASES[0])), dir.c_str());
+  return failed ? 1 : 0;
+}
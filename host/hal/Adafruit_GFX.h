@@ -0,0 +1,65 @@
+#pragma once
+
+// Host stand-in for Adafruit_GFX: the primitives the sketch uses, with the
+// library's pixel algorithms (Bresenham lines, midpoint circles, the classic
+// 6x8 text cell and its wrapping and bounds). Glyphs are NOT the library's
+// font: each character draws a fixed pattern derived from its code, so text
+// placement, width and changes show up in frames but letters don't read.
+//
+// Every public call is counted (gfxCalls) and so is every pixel written
+// (pixelWrites); Host.h turns those into per-frame call and overdraw counts.
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h);
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+
+  void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+  void setTextSize(uint8_t s) { textSize = s > 0 ? s : 1; }
+  void setTextColor(uint16_t c) { textColor = textBg = c; }
+  void setTextColor(uint16_t c, uint16_t bg) { textColor = c; textBg = bg; }
+  void setTextWrap(bool w) { wrap = w; }
+  void getTextBounds(const char* s, int16_t x, int16_t y,
+                     int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h);
+  void getTextBounds(const __FlashStringHelper* s, int16_t x, int16_t y,
+                     int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h);
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+  int16_t getCursorX() const { return cursorX; }
+  int16_t getCursorY() const { return cursorY; }
+
+  unsigned long gfxCalls = 0;
+  unsigned long pixelWrites = 0;
+
+protected:
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+  void charBounds(unsigned char c, int16_t* x, int16_t* y,
+                  int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy);
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color);
+  void vline(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void hline(int16_t x, int16_t y, int16_t w, uint16_t color);
+
+  int16_t  _width, _height;
+  int16_t  cursorX = 0, cursorY = 0;
+  uint16_t textColor = 0xFFFF, textBg = 0xFFFF;
+  uint8_t  textSize = 1;
+  bool     wrap = true;
+  uint8_t  depth = 0;   // nested primitive calls count once
+};
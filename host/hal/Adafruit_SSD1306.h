@@ -0,0 +1,46 @@
+#pragma once
+
+// In-memory 128x64 SSD1306: the same page-major framebuffer layout as the
+// library (getBuffer), plus the panel state a harness wants to see
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_BLACK   0
+#define SSD1306_WHITE   1
+#define SSD1306_INVERSE 2
+#define BLACK   SSD1306_BLACK
+#define WHITE   SSD1306_WHITE
+#define INVERSE SSD1306_INVERSE
+
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_EXTERNALVCC  0x01
+#define SSD1306_DISPLAYOFF   0xAE
+#define SSD1306_DISPLAYON    0xAF
+#define SSD1306_COLUMNADDR   0x21
+#define SSD1306_PAGEADDR     0x22
+#define SSD1306_INVERTDISPLAY 0xA7
+#define SSD1306_NORMALDISPLAY 0xA6
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+  Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rstPin = -1);
+
+  bool begin(uint8_t vccState = SSD1306_SWITCHCAPVCC, uint8_t addr = 0, bool reset = true, bool periphBegin = true);
+  void display();
+  void clearDisplay();
+  void invertDisplay(bool i);
+  void dim(bool) {}
+  void ssd1306_command(uint8_t c);
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  bool getPixel(int16_t x, int16_t y);
+  uint8_t* getBuffer() { return buffer; }
+
+  // Panel state for the harness
+  unsigned long flushes = 0;   // display() calls
+  bool panelOn = true;
+  bool inverted = false;
+  uint8_t touched[128 * 64 / 8];   // pixels written since Host::resetDrawCounts()
+
+private:
+  uint8_t buffer[128 * 64 / 8];
+};
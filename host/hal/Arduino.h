@@ -0,0 +1,111 @@
+#pragma once
+
+// Host stand-in for the Arduino AVR core: just enough of Arduino.h to build
+// the sketch unchanged on Linux. Time is a virtual clock the harness moves
+// (Host::advanceUs); pins, tones, Serial and EEPROM are in-memory models.
+// Host.h is the harness side of all of it.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "Print.h"
+#include "binary.h"
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+typedef bool    boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+// Mega 2560 analog pins
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define LED_BUILTIN 13
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+// Same function-like macros as the AVR core, so name clashes that would
+// break the board build break the host build too
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+#define interrupts()   sei()
+#define noInterrupts() cli()
+
+#define lowByte(w)  ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bitRead(value, b)  (((value) >> (b)) & 0x01)
+#define bitSet(value, b)   ((value) |= (1UL << (b)))
+#define bitClear(value, b) ((value) &= ~(1UL << (b)))
+#define bitWrite(value, b, v) ((v) ? bitSet(value, b) : bitClear(value, b))
+#define bit(b) (1UL << (b))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+void tone(uint8_t pin, unsigned int hz, unsigned long durationMs = 0);
+void noTone(uint8_t pin);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+// Serial0 with a 64-byte TX ring drained at the configured baud rate in
+// virtual time (Host::setBaud); write() on a full ring waits, as on the board
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud);
+  void end() {}
+  int available() override;
+  int read() override;
+  int peek() override;
+  int availableForWrite() override;
+  void flush() override;
+  size_t write(uint8_t c) override;
+  using Print::write;
+  operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
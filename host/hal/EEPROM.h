@@ -0,0 +1,25 @@
+#pragma once
+
+// 4 KB EEPROM (Mega 2560) in RAM, erased to 0xFF; Host.h loads and saves it
+#include <stdint.h>
+#include <avr/eeprom.h>
+
+struct EEPROMClass {
+  uint8_t read(int addr);
+  void write(int addr, uint8_t val);
+  void update(int addr, uint8_t val);
+  uint16_t length() { return 4096; }
+
+  template <typename T> T& get(int addr, T& t) {
+    uint8_t* p = (uint8_t*)&t;
+    for (unsigned i = 0; i < sizeof(T); ++i) p[i] = read(addr + i);
+    return t;
+  }
+  template <typename T> const T& put(int addr, const T& t) {
+    const uint8_t* p = (const uint8_t*)&t;
+    for (unsigned i = 0; i < sizeof(T); ++i) update(addr + i, p[i]);
+    return t;
+  }
+};
+
+extern EEPROMClass EEPROM;
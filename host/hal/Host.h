@@ -0,0 +1,77 @@
+#pragma once
+
+// Harness side of the host HAL: drive the virtual clock and inputs, read back
+// pins, tones, Serial output, EEPROM and the panel. Include the standard
+// headers you need before this (Arduino.h defines min/max/... as macros).
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+
+class Adafruit_SSD1306;
+
+namespace Host {
+
+// ---- Clock ----
+// nowUs() is what millis()/micros() see; it stops while the MCU sleeps.
+// wallUs() keeps running (scripted operators live on it).
+uint64_t nowUs();
+uint64_t wallUs();
+void advanceUs(uint32_t us);
+// Also advance both clocks by host CPU time between reads, so micros() spans
+// time real code (ReactorBench cases). Runs stop being reproducible.
+void useHostClock(bool on);
+
+// ---- Pins ----
+void setInput(uint8_t pin, bool level);   // buttons: LOW = pressed
+int  pinLevel(uint8_t pin);
+unsigned long pinWrites();
+void setAnalog(uint8_t pin, int value);
+
+// ---- Buzzer ----
+struct ToneEvent {
+  uint64_t atUs;
+  uint16_t hz;   // 0 = noTone
+};
+const std::vector<ToneEvent>& tones();
+void clearTones();
+uint16_t toneHz();
+
+// ---- Serial ----
+void serialInput(const std::string& bytes);
+void setSerialSink(FILE* f);        // TX bytes also go here (0 = nowhere)
+std::string takeSerialOutput();     // everything written since the last call
+void setBaud(uint32_t baud);        // TX drain rate; 0 = instant
+
+// ---- EEPROM ----
+void eraseEeprom();
+bool loadEeprom(const char* path);
+bool saveEeprom(const char* path);
+
+// ---- Panel ----
+// FNV-1a of a framebuffer, and PBM (P4) output of one
+uint32_t frameHash(const uint8_t* buf);
+void writePbm(FILE* f, const uint8_t* buf);
+// Drawing since the last resetDrawCounts(): GFX calls, pixel writes and
+// distinct pixels written (writes / pixels is the overdraw)
+struct DrawCounts {
+  unsigned long calls;
+  unsigned long writes;
+  unsigned long pixels;
+};
+void resetDrawCounts(Adafruit_SSD1306& d);
+DrawCounts drawCounts(const Adafruit_SSD1306& d);
+
+// ---- Sleep ----
+// Called from sleep_cpu(). The handler should move wallUs() on (advanceAsleepUs)
+// to the next change on a wake-armed pin, apply it with setInput() and return
+// true; false means nothing will ever wake the MCU.
+typedef bool (*SleepHandler)();
+void setSleepHandler(SleepHandler h);
+void advanceAsleepUs(uint64_t us);
+bool wakeArmed(uint8_t pin);        // pin change interrupt enabled for pin
+unsigned long sleeps();
+
+} // namespace Host
@@ -0,0 +1,316 @@
+#include "Host.h"
+#include <Adafruit_SSD1306.h>
+
+// ======================= Adafruit_GFX stand-in =======================
+
+namespace {
+  // Counts a public primitive once, however many it calls internally
+  struct CallScope {
+    explicit CallScope(Adafruit_GFX* g, uint8_t& d) : depth(d) {
+      if (!depth++) ++g->gfxCalls;
+    }
+    ~CallScope() { --depth; }
+    uint8_t& depth;
+  };
+
+  // Placeholder glyph column: stable per (character, column), blank for space
+  uint8_t glyphColumn(unsigned char c, uint8_t i) {
+    if (c == ' ') return 0;
+    uint32_t h = c * 2654435761u + (i + 1) * 40503u;
+    h ^= h >> 15;
+    return (uint8_t)((h >> 8) & 0x7F);
+  }
+
+  template <typename T> void swapT(T& a, T& b) { T t = a; a = b; b = t; }
+}
+
+#define GFX_CALL CallScope scope_(this, depth)
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+
+void Adafruit_GFX::vline(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (h < 0) { y += h + 1; h = -h; }
+  for (int16_t i = 0; i < h; ++i) drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (w < 0) { x += w + 1; w = -w; }
+  for (int16_t i = 0; i < w; ++i) drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  GFX_CALL;
+  vline(x, y, h, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  GFX_CALL;
+  hline(x, y, w, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  GFX_CALL;
+  if (x0 == x1) {
+    if (y0 > y1) swapT(y0, y1);
+    vline(x0, y0, y1 - y0 + 1, color);
+    return;
+  }
+  if (y0 == y1) {
+    if (x0 > x1) swapT(x0, x1);
+    hline(x0, y0, x1 - x0 + 1, color);
+    return;
+  }
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) { swapT(x0, y0); swapT(x1, y1); }
+  if (x0 > x1) { swapT(x0, x1); swapT(y0, y1); }
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = y0 < y1 ? 1 : -1;
+  for (; x0 <= x1; ++x0) {
+    if (steep) drawPixel(y0, x0, color);
+    else       drawPixel(x0, y0, color);
+    err -= dy;
+    if (err < 0) { y0 += ystep; err += dx; }
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  GFX_CALL;
+  hline(x, y, w, color);
+  hline(x, y + h - 1, w, color);
+  vline(x, y, h, color);
+  vline(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  GFX_CALL;
+  for (int16_t i = x; i < x + w; ++i) vline(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  GFX_CALL;
+  int16_t f = 1 - r, ddFx = 1, ddFy = -2 * r, x = 0, y = r;
+  drawPixel(x0, y0 + r, color);
+  drawPixel(x0, y0 - r, color);
+  drawPixel(x0 + r, y0, color);
+  drawPixel(x0 - r, y0, color);
+  while (x < y) {
+    if (f >= 0) { --y; ddFy += 2; f += ddFy; }
+    ++x;
+    ddFx += 2;
+    f += ddFx;
+    drawPixel(x0 + x, y0 + y, color);
+    drawPixel(x0 - x, y0 + y, color);
+    drawPixel(x0 + x, y0 - y, color);
+    drawPixel(x0 - x, y0 - y, color);
+    drawPixel(x0 + y, y0 + x, color);
+    drawPixel(x0 - y, y0 + x, color);
+    drawPixel(x0 + y, y0 - x, color);
+    drawPixel(x0 - y, y0 - x, color);
+  }
+}
+
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                                    int16_t delta, uint16_t color) {
+  int16_t f = 1 - r, ddFx = 1, ddFy = -2 * r, x = 0, y = r, px = x, py = y;
+  ++delta;
+  while (x < y) {
+    if (f >= 0) { --y; ddFy += 2; f += ddFy; }
+    ++x;
+    ddFx += 2;
+    f += ddFx;
+    if (x < y + 1) {
+      if (corners & 1) vline(x0 + x, y0 - y, 2 * y + delta, color);
+      if (corners & 2) vline(x0 - x, y0 - y, 2 * y + delta, color);
+    }
+    if (y != py) {
+      if (corners & 1) vline(x0 + py, y0 - px, 2 * px + delta, color);
+      if (corners & 2) vline(x0 - py, y0 - px, 2 * px + delta, color);
+      py = y;
+    }
+    px = x;
+  }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  GFX_CALL;
+  vline(x0, y0 - r, 2 * r + 1, color);
+  fillCircleHelper(x0, y0, r, 3, 0, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                              uint16_t color) {
+  GFX_CALL;
+  int16_t byteWidth = (w + 7) / 8;
+  uint8_t b = 0;
+  for (int16_t j = 0; j < h; ++j, ++y) {
+    for (int16_t i = 0; i < w; ++i) {
+      if (i & 7) b <<= 1;
+      else       b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      if (b & 0x80) drawPixel(x + i, y, color);
+    }
+  }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                            uint8_t size) {
+  if (x >= _width || y >= _height || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0) return;
+  for (int8_t i = 0; i < 5; ++i) {
+    uint8_t line = glyphColumn(c, i);
+    for (int8_t j = 0; j < 8; ++j, line >>= 1) {
+      uint16_t ink;
+      if (line & 1)        ink = color;
+      else if (bg != color) ink = bg;
+      else                 continue;
+      if (size == 1) drawPixel(x + i, y + j, ink);
+      else for (uint8_t dx = 0; dx < size; ++dx) vline(x + i * size + dx, y + j * size, size, ink);
+    }
+  }
+  if (bg != color) {
+    for (uint8_t dx = 0; dx < size; ++dx) vline(x + 5 * size + dx, y, 8 * size, bg);
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  GFX_CALL;
+  if (c == '\n') {
+    cursorX = 0;
+    cursorY += textSize * 8;
+  } else if (c != '\r') {
+    if (wrap && cursorX + textSize * 6 > _width) {
+      cursorX = 0;
+      cursorY += textSize * 8;
+    }
+    drawChar(cursorX, cursorY, c, textColor, textBg, textSize);
+    cursorX += textSize * 6;
+  }
+  return 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t* x, int16_t* y,
+                              int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy) {
+  if (c == '\n') {
+    *x = 0;
+    *y += textSize * 8;
+  } else if (c != '\r') {
+    if (wrap && *x + textSize * 6 > _width) {
+      *x = 0;
+      *y += textSize * 8;
+    }
+    int16_t x2 = *x + textSize * 6 - 1, y2 = *y + textSize * 8 - 1;
+    if (x2 > *maxx) *maxx = x2;
+    if (y2 > *maxy) *maxy = y2;
+    if (*x < *minx) *minx = *x;
+    if (*y < *miny) *miny = *y;
+    *x += textSize * 6;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char* s, int16_t x, int16_t y,
+                                 int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+  while (unsigned char c = *s++) charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  if (maxx >= minx) { *x1 = minx; *w = maxx - minx + 1; }
+  if (maxy >= miny) { *y1 = miny; *h = maxy - miny + 1; }
+}
+
+void Adafruit_GFX::getTextBounds(const __FlashStringHelper* s, int16_t x, int16_t y,
+                                 int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+  getTextBounds((const char*)s, x, y, x1, y1, w, h);
+}
+
+// ======================= Adafruit_SSD1306 stand-in =======================
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire*, int8_t)
+  : Adafruit_GFX(w, h) {
+  memset(buffer, 0, sizeof(buffer));
+  memset(touched, 0, sizeof(touched));
+}
+
+bool Adafruit_SSD1306::begin(uint8_t, uint8_t, bool, bool) {
+  clearDisplay();
+  panelOn = true;
+  return true;
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+  Wire.beginTransmission(0x3C);
+  Wire.write((uint8_t)0x00);
+  Wire.write(c);
+  Wire.endTransmission();
+  if (c == SSD1306_DISPLAYOFF) panelOn = false;
+  if (c == SSD1306_DISPLAYON)  panelOn = true;
+}
+
+// Same bus traffic as the library: one command list, then the buffer in
+// Wire-buffer-sized data chunks
+void Adafruit_SSD1306::display() {
+  ++flushes;
+  Wire.beginTransmission(0x3C);
+  Wire.write((uint8_t)0x00);
+  const uint8_t cmds[] = { SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0, 127 };
+  Wire.write(cmds, sizeof(cmds));
+  Wire.endTransmission();
+  uint16_t left = sizeof(buffer);
+  while (left) {
+    uint8_t n = left < BUFFER_LENGTH - 1 ? left : BUFFER_LENGTH - 1;
+    Wire.beginTransmission(0x3C);
+    Wire.write((uint8_t)0x40);
+    Wire.write(buffer, n);
+    Wire.endTransmission();
+    left -= n;
+  }
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  memset(buffer, 0, sizeof(buffer));
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+  ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+  inverted = i;
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  ++pixelWrites;
+  uint16_t i = x + (y / 8) * _width;
+  uint8_t  m = 1 << (y & 7);
+  touched[(x + y * _width) / 8] |= 1 << ((x + y * _width) & 7);
+  switch (color) {
+    case SSD1306_WHITE:   buffer[i] |= m; break;
+    case SSD1306_BLACK:   buffer[i] &= ~m; break;
+    case SSD1306_INVERSE: buffer[i] ^= m; break;
+  }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return false;
+  return buffer[x + (y / 8) * _width] & (1 << (y & 7));
+}
+
+// ======================= Harness counters =======================
+
+namespace Host {
+
+void resetDrawCounts(Adafruit_SSD1306& d) {
+  d.gfxCalls = 0;
+  d.pixelWrites = 0;
+  memset(d.touched, 0, sizeof(d.touched));
+}
+
+DrawCounts drawCounts(const Adafruit_SSD1306& d) {
+  DrawCounts c = { d.gfxCalls, d.pixelWrites, 0 };
+  for (uint16_t i = 0; i < sizeof(d.touched); ++i) c.pixels += __builtin_popcount(d.touched[i]);
+  return c;
+}
+
+} // namespace Host
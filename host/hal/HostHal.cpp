@@ -0,0 +1,420 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Host.h"
+#include <Wire.h>
+#include <EEPROM.h>
+#include <avr/sleep.h>
+
+// ======================= Registers / SRAM =======================
+volatile uint8_t  SREG, MCUSR, ADCSRA;
+volatile uint8_t  PCICR, PCMSK0, PCIFR;
+volatile uint8_t  TCCR1A, TCCR1B, TIMSK1;
+HostFlags         TIFR1;
+HostTimer1        TCNT1;
+
+uint8_t Host_sram[8192];
+char    __heap_start;
+char*   __brkval = (char*)Host_sram + 4096;
+
+// Interrupt handlers the sketch may or may not define
+extern "C" __attribute__((weak)) void PCINT0_vect();
+extern "C" __attribute__((weak)) void TIMER1_OVF_vect();
+
+namespace {
+  // ---- Clock ----
+  uint64_t nowUs_  = 0;
+  uint64_t wallUs_ = 0;
+  bool     hostClock = false;
+  std::chrono::steady_clock::time_point hostLast;
+  uint64_t hostNsCarry = 0;
+
+  // ---- Timer1 ----
+  const uint8_t CYCLES_PER_US = 16;
+  uint64_t t1Zero = 0;     // clock cycle at which the count was 0
+  uint16_t t1Held = 0;     // count while stopped
+
+  inline bool t1Running() { return TCCR1B & _BV(CS10); }
+
+  // Overflows between two clock readings
+  void runTimer1(uint64_t fromUs, uint64_t toUs) {
+    if (!t1Running()) return;
+    uint64_t wraps = ((toUs * CYCLES_PER_US - t1Zero) >> 16) - ((fromUs * CYCLES_PER_US - t1Zero) >> 16);
+    for (; wraps; --wraps) {
+      TIFR1.bits |= _BV(TOV1);
+      if (!TIMER1_OVF_vect || !(TIMSK1 & _BV(TOIE1))) continue;
+      TIFR1.bits &= ~_BV(TOV1);   // cleared on entry to the handler
+      TIMER1_OVF_vect();
+    }
+  }
+
+  void advanceClocks(uint64_t us) {
+    runTimer1(nowUs_, nowUs_ + us);
+    nowUs_  += us;
+    wallUs_ += us;
+  }
+
+  // With the host clock on, CPU time spent since the last read counts too
+  void syncHostClock() {
+    if (!hostClock) return;
+    std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+    hostNsCarry += std::chrono::duration_cast<std::chrono::nanoseconds>(t - hostLast).count();
+    hostLast = t;
+    advanceClocks(hostNsCarry / 1000);
+    hostNsCarry %= 1000;
+  }
+
+  // ---- Pins ----
+  const uint8_t PIN_COUNT = 70;
+  uint8_t       level[PIN_COUNT];
+  int           analog[PIN_COUNT];
+  unsigned long writes = 0;
+
+  // ---- Buzzer ----
+  std::vector<Host::ToneEvent> toneLog;
+  uint16_t toneNow = 0;
+
+  // ---- Serial ----
+  std::string   rx;
+  size_t        rxPos = 0;
+  std::string   txCapture;
+  FILE*         txSink = 0;
+  uint32_t      baud = 115200;
+  const int     TX_RING = 63;      // SERIAL_TX_BUFFER_SIZE - 1
+  int           txQueued = 0;
+  uint64_t      txDrainedAt = 0;
+
+  // ---- EEPROM ----
+  uint8_t eeprom[4096];
+  bool    eepromInit = false;
+
+  // ---- Sleep ----
+  Host::SleepHandler sleepHandler = 0;
+  unsigned long      sleepCount = 0;
+
+  // ---- avr-libc random() (Park-Miller minimal standard) ----
+  unsigned long randomNext = 1;
+
+  void drainTx() {
+    if (!baud) { txQueued = 0; txDrainedAt = wallUs_; return; }
+    uint64_t byteUs = 10000000ULL / baud;   // 8N1
+    while (txQueued && wallUs_ - txDrainedAt >= byteUs) {
+      txDrainedAt += byteUs;
+      --txQueued;
+    }
+    if (!txQueued) txDrainedAt = wallUs_;
+  }
+
+  void ensureEeprom() {
+    if (eepromInit) return;
+    memset(eeprom, 0xFF, sizeof(eeprom));
+    eepromInit = true;
+  }
+
+  // Mega 2560 PORTB pins on PCINT0..7
+  int8_t pcintBit(uint8_t pin) {
+    switch (pin) {
+      case 53: return 0;
+      case 52: return 1;
+      case 51: return 2;
+      case 50: return 3;
+      case 10: return 4;
+      case 11: return 5;
+      case 12: return 6;
+      case 13: return 7;
+      default: return -1;
+    }
+  }
+}
+
+// ======================= Arduino API =======================
+unsigned long millis() { syncHostClock(); return (unsigned long)(nowUs_ / 1000); }
+unsigned long micros() { syncHostClock(); return (unsigned long)nowUs_; }
+void delay(unsigned long ms) { Host::advanceUs(ms * 1000); }
+void delayMicroseconds(unsigned int us) { Host::advanceUs(us); }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < PIN_COUNT && mode == INPUT_PULLUP) level[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < PIN_COUNT) level[pin] = val ? HIGH : LOW;
+  ++writes;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < PIN_COUNT ? level[pin] : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  return pin < PIN_COUNT ? analog[pin] : 0;
+}
+
+void analogWrite(uint8_t pin, int val) {
+  digitalWrite(pin, val > 127 ? HIGH : LOW);
+}
+
+void tone(uint8_t, unsigned int hz, unsigned long) {
+  if (hz == toneNow) return;
+  toneNow = hz;
+  toneLog.push_back({ nowUs_, (uint16_t)hz });
+}
+
+void noTone(uint8_t) {
+  if (!toneNow) return;
+  toneNow = 0;
+  toneLog.push_back({ nowUs_, 0 });
+}
+
+long random(long howbig) {
+  if (howbig == 0) return 0;
+  long x = (long)randomNext;
+  if (x == 0) x = 123459876L;
+  long hi = x / 127773L;
+  long lo = x % 127773L;
+  x = 16807L * lo - 2836L * hi;
+  if (x < 0) x += 0x7fffffffL;
+  randomNext = (unsigned long)x;
+  return (x % 0x80000000L) % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) randomNext = seed;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ======================= Serial =======================
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long) {}
+
+int HardwareSerial::available() {
+  return (int)(rx.size() - rxPos);
+}
+
+int HardwareSerial::read() {
+  if (rxPos >= rx.size()) return -1;
+  int c = (uint8_t)rx[rxPos++];
+  if (rxPos == rx.size()) { rx.clear(); rxPos = 0; }
+  return c;
+}
+
+int HardwareSerial::peek() {
+  return rxPos < rx.size() ? (uint8_t)rx[rxPos] : -1;
+}
+
+int HardwareSerial::availableForWrite() {
+  drainTx();
+  return TX_RING - txQueued;
+}
+
+void HardwareSerial::flush() {
+  while (availableForWrite() < TX_RING) Host::advanceUs(10);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  // A full ring blocks the caller until the UART frees a slot
+  while (availableForWrite() <= 0) Host::advanceUs(10);
+  if (baud) ++txQueued;
+  txCapture.push_back((char)c);
+  if (txSink) fputc(c, txSink);
+  return 1;
+}
+
+// ======================= Wire =======================
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t) {
+  pending = 1;   // address byte
+}
+
+size_t TwoWire::write(uint8_t) {
+  ++pending;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t*, size_t n) {
+  pending += n;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  ++transactions;
+  bytes += pending;
+  // 9 clocks per byte (data + ACK) plus start and stop
+  Host::advanceUs((uint32_t)(((uint64_t)pending * 9 + 2) * 1000000ULL / clockHz));
+  pending = 0;
+  return 0;
+}
+
+// ======================= EEPROM =======================
+EEPROMClass EEPROM;
+
+uint8_t EEPROMClass::read(int addr) {
+  ensureEeprom();
+  return eeprom[addr & 0xFFF];
+}
+
+void EEPROMClass::write(int addr, uint8_t val) {
+  ensureEeprom();
+  eeprom[addr & 0xFFF] = val;
+}
+
+void EEPROMClass::update(int addr, uint8_t val) {
+  write(addr, val);
+}
+
+// ======================= Timer1 =======================
+HostTimer1::operator uint16_t() const {
+  if (!t1Running()) return t1Held;
+  syncHostClock();
+  return (uint16_t)(nowUs_ * CYCLES_PER_US - t1Zero);
+}
+
+HostTimer1& HostTimer1::operator=(uint16_t count) {
+  t1Held = count;
+  t1Zero = nowUs_ * CYCLES_PER_US - count;
+  return *this;
+}
+
+// ======================= Sleep =======================
+uint8_t Host_sleepMode = SLEEP_MODE_IDLE;
+
+void Host_sleep() {
+  // Idle: Timer0 overflows every 1024 us and wakes the CPU
+  if (Host_sleepMode == SLEEP_MODE_IDLE) {
+    Host::advanceUs(1024 - (uint32_t)(nowUs_ % 1024));
+    return;
+  }
+  ++sleepCount;
+  if (!sleepHandler || !sleepHandler()) return;
+  if (PCINT0_vect && (PCICR & _BV(PCIE0))) PCINT0_vect();
+}
+
+// ======================= Harness API =======================
+namespace Host {
+
+uint64_t nowUs()  { return nowUs_; }
+uint64_t wallUs() { return wallUs_; }
+
+void advanceUs(uint32_t us) {
+  advanceClocks(us);
+}
+
+void useHostClock(bool on) {
+  hostClock = on;
+  hostLast = std::chrono::steady_clock::now();
+  hostNsCarry = 0;
+}
+
+void advanceAsleepUs(uint64_t us) {
+  wallUs_ += us;
+}
+
+void setInput(uint8_t pin, bool lvl) {
+  if (pin < PIN_COUNT) level[pin] = lvl ? HIGH : LOW;
+}
+
+int pinLevel(uint8_t pin) {
+  return digitalRead(pin);
+}
+
+unsigned long pinWrites() {
+  return writes;
+}
+
+void setAnalog(uint8_t pin, int value) {
+  if (pin < PIN_COUNT) analog[pin] = value;
+}
+
+const std::vector<ToneEvent>& tones() { return toneLog; }
+void clearTones() { toneLog.clear(); }
+uint16_t toneHz() { return toneNow; }
+
+void serialInput(const std::string& bytes) {
+  rx += bytes;
+}
+
+void setSerialSink(FILE* f) {
+  txSink = f;
+}
+
+std::string takeSerialOutput() {
+  std::string out;
+  out.swap(txCapture);
+  return out;
+}
+
+void setBaud(uint32_t b) {
+  drainTx();
+  baud = b;
+}
+
+void eraseEeprom() {
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  eepromInit = true;
+}
+
+bool loadEeprom(const char* path) {
+  ensureEeprom();
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  bool ok = fread(eeprom, 1, sizeof(eeprom), f) == sizeof(eeprom);
+  fclose(f);
+  return ok;
+}
+
+bool saveEeprom(const char* path) {
+  ensureEeprom();
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(eeprom, 1, sizeof(eeprom), f) == sizeof(eeprom);
+  fclose(f);
+  return ok;
+}
+
+uint32_t frameHash(const uint8_t* buf) {
+  uint32_t h = 2166136261u;
+  for (int i = 0; i < 1024; ++i) {
+    h ^= buf[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+void writePbm(FILE* f, const uint8_t* buf) {
+  fprintf(f, "P4\n128 64\n");
+  for (int y = 0; y < 64; ++y) {
+    for (int xb = 0; xb < 16; ++xb) {
+      uint8_t out = 0;
+      for (int b = 0; b < 8; ++b) {
+        int x = xb * 8 + b;
+        if (buf[(y / 8) * 128 + x] & (1 << (y & 7))) out |= 0x80 >> b;
+      }
+      fputc(out, f);
+    }
+  }
+}
+
+void setSleepHandler(SleepHandler h) {
+  sleepHandler = h;
+}
+
+bool wakeArmed(uint8_t pin) {
+  int8_t b = pcintBit(pin);
+  return b >= 0 && (PCICR & _BV(PCIE0)) && (PCMSK0 & _BV(b));
+}
+
+unsigned long sleeps() {
+  return sleepCount;
+}
+
+} // namespace Host
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// Print / Stream as in the Arduino core (no String support)
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n) {
+    size_t done = 0;
+    while (n--) done += write(*buf++);
+    return done;
+  }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t write(const char* buf, size_t n) { return write((const uint8_t*)buf, n); }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper* s) { return write((const char*)s); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return printNumber(v, base); }
+  size_t print(int v, int base = DEC) { return printSigned(v, base); }
+  size_t print(unsigned int v, int base = DEC) { return printNumber(v, base); }
+  size_t print(long v, int base = DEC) { return printSigned(v, base); }
+  size_t print(unsigned long v, int base = DEC) { return printNumber(v, base); }
+  size_t print(double v, int digits = 2) {
+    char b[48];
+    snprintf(b, sizeof(b), "%.*f", digits, v);
+    return write(b);
+  }
+
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+
+private:
+  size_t printNumber(unsigned long v, int base) {
+    if (base < 2) base = 10;
+    char b[8 * sizeof(long) + 1];
+    char* p = &b[sizeof(b) - 1];
+    *p = '\0';
+    do {
+      unsigned long d = v % base;
+      v /= base;
+      *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+    } while (v);
+    return write(p);
+  }
+  size_t printSigned(long v, int base) {
+    if (base == 10 && v < 0) return print('-') + printNumber((unsigned long)-v, 10);
+    return printNumber((unsigned long)v, base);
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
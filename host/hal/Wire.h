@@ -0,0 +1,27 @@
+#pragma once
+
+// I2C at the configured clock in virtual time: every transaction advances the
+// clock by its bit time (9 bits per byte plus start/address/stop), so panel
+// flushes cost what they cost on the board. Bytes are counted, not decoded.
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 32
+
+class TwoWire {
+public:
+  void begin() {}
+  void setClock(uint32_t hz) { clockHz = hz; }
+  void beginTransmission(uint8_t addr);
+  uint8_t endTransmission(bool stop = true);
+  size_t write(uint8_t b);
+  size_t write(const uint8_t* b, size_t n);
+
+  uint32_t      clockHz = 100000;
+  unsigned long transactions = 0;
+  unsigned long bytes = 0;
+
+private:
+  uint16_t pending = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,9 @@
+#pragma once
+
+// Handlers get C linkage so the harness can raise them (Host.h)
+#define ISR(vector) extern "C" void vector()
+#define cli()
+#define sei()
+
+extern "C" void PCINT0_vect();
+extern "C" void TIMER1_OVF_vect();
@@ -0,0 +1,44 @@
+#pragma once
+
+// ATmega2560 registers the sketch touches, as plain bytes. Writes are only
+// remembered; the harness reads PCICR/PCMSK0 to know which pins wake sleep.
+// Timer1 is the exception: see HostTimer1 and HostFlags.
+#include <stdint.h>
+
+extern volatile uint8_t  SREG, MCUSR, ADCSRA;
+extern volatile uint8_t  PCICR, PCMSK0, PCIFR;
+extern volatile uint8_t  TCCR1A, TCCR1B, TIMSK1;
+
+// Interrupt flags: writing a 1 clears that flag, as on the AVR
+struct HostFlags {
+  volatile uint8_t bits;
+  operator uint8_t() const { return bits; }
+  HostFlags& operator=(uint8_t clear) { bits &= ~clear; return *this; }
+};
+extern HostFlags TIFR1;
+
+// Timer1 at clk/1 (CS10 set) counts the virtual clock at 16 cycles per us.
+// Each wrap raises TIMER1_OVF_vect when TOIE1 is set, else sets TOV1.
+struct HostTimer1 {
+  operator uint16_t() const;
+  HostTimer1& operator=(uint16_t count);
+};
+extern HostTimer1 TCNT1;
+
+#define _BV(b) (1U << (b))
+
+#define ADEN   7
+#define PCIE0  0
+#define PCIF0  0
+#define PCINT4 4
+#define TOV1   0
+#define TOIE1  0
+#define CS10   0
+
+// Stack and heap bounds point into a fake 8 KB SRAM so ReactorDiag's stack
+// painting runs; its figures mean nothing on the host
+extern uint8_t Host_sram[8192];
+#define RAMSTART ((uintptr_t)Host_sram)
+#define RAMEND   ((uintptr_t)(Host_sram + sizeof(Host_sram) - 1))
+#define SP       ((uintptr_t)(Host_sram + sizeof(Host_sram) - 256))
+#define E2END    0xFFF
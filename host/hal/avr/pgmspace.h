@@ -0,0 +1,26 @@
+#pragma once
+
+// Flash and RAM are one address space on the host
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PGM_P  const char*
+#define PSTR(s) (s)
+
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_float(p) (*(const float*)(p))
+#define pgm_read_ptr(p)   (*(void* const*)(p))
+
+#define memcpy_P     memcpy
+#define memcmp_P     memcmp
+#define strlen_P     strlen
+#define strcmp_P     strcmp
+#define strncmp_P    strncmp
+#define strcasecmp_P strcasecmp
+#define strcpy_P     strcpy
+#define strncpy_P    strncpy
+#define snprintf_P   snprintf
@@ -0,0 +1,18 @@
+#pragma once
+
+// sleep_cpu() hands control to the harness. In power-down it stops the
+// millis()/micros() clock and returns once a pin change the sketch armed
+// would wake the MCU; in idle the clock runs on to the next Timer0 tick.
+#include <stdint.h>
+
+#define SLEEP_MODE_IDLE     0
+#define SLEEP_MODE_PWR_DOWN 2
+
+extern uint8_t Host_sleepMode;
+void Host_sleep();
+
+#define set_sleep_mode(mode) (Host_sleepMode = (mode))
+#define sleep_enable()
+#define sleep_disable()
+#define sleep_bod_disable()
+#define sleep_cpu() Host_sleep()
@@ -0,0 +1,6 @@
+#pragma once
+
+// Single-threaded host: the block simply runs once
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON      1
+#define ATOMIC_BLOCK(type) for (int atomicOnce_ = 1; atomicOnce_; atomicOnce_ = 0)
@@ -0,0 +1,174 @@
+// reactor_host: the unmodified sketch on the host HAL, in virtual time.
+//
+//   reactor_host [--until MS] [--step US] [--press "MS:B[:HOLD],..."]
+//                [--rx "MS:text"]... [--baud N] [--eeprom FILE]
+//                [--serial FILE|-] [--frames] [--tones] [--pbm FILE]
+//                [--sample MS] [--host-clock]
+//
+// Every loop() pass is followed by --step of virtual CPU time (default 500 us);
+// I2C and Serial add their own bus time on top. Mode transitions print as they
+// happen; a summary follows at --until (default 60000 ms of wall time).
+// --sample prints heat percent, frame hash and the output pins every MS, for
+// diffing two builds of the sketch against the same script. --host-clock adds
+// real CPU time to the virtual clock (timings such as the bench's ns/frame).
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Operator.h"
+#include "../ReactorDiag.h"
+#include "../ReactorHeat.h"
+#include "../ReactorStateMachine.h"
+#include "../ReactorUI.h"
+
+void setup();
+void loop();
+
+namespace {
+  struct ErrPrint : Print {
+    size_t write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+    using Print::write;
+  } err;
+
+  // "\n" and "\r" escapes so a console line fits on the command line
+  std::string unescape(const char* s) {
+    std::string out;
+    for (; *s; ++s) {
+      if (*s == '\\' && s[1] == 'n') { out += '\n'; ++s; }
+      else if (*s == '\\' && s[1] == 'r') { out += '\r'; ++s; }
+      else out += *s;
+    }
+    return out;
+  }
+
+  int usage() {
+    fprintf(stderr, "usage: reactor_host [--until MS] [--step US] [--press \"MS:B[:HOLD],...\"]\n"
+                    "                    [--rx \"MS:text\"]... [--baud N] [--eeprom FILE]\n"
+                    "                    [--serial FILE|-] [--frames] [--tones] [--pbm FILE]\n"
+                    "                    [--sample MS] [--host-clock]\n");
+    return 2;
+  }
+}
+
+int main(int argc, char** argv) {
+  uint64_t    untilMs = 60000;
+  uint64_t    sampleMs = 0;
+  uint32_t    stepUs = 500;
+  const char* eepromPath = 0;
+  const char* serialPath = 0;
+  const char* pbmPath = 0;
+  bool        frames = false, showTones = false;
+  std::vector<Operator::Press> presses;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    bool more = i + 1 < argc;
+    if (a == "--until" && more)       untilMs = strtoull(argv[++i], 0, 10);
+    else if (a == "--step" && more)   stepUs = strtoul(argv[++i], 0, 10);
+    else if (a == "--baud" && more)   Host::setBaud(strtoul(argv[++i], 0, 10));
+    else if (a == "--eeprom" && more) eepromPath = argv[++i];
+    else if (a == "--serial" && more) serialPath = argv[++i];
+    else if (a == "--pbm" && more)    pbmPath = argv[++i];
+    else if (a == "--sample" && more) sampleMs = strtoull(argv[++i], 0, 10);
+    else if (a == "--frames")         frames = true;
+    else if (a == "--tones")          showTones = true;
+    else if (a == "--host-clock")     Host::useHostClock(true);
+    else if (a == "--press" && more) {
+      if (!Operator::parsePresses(argv[++i], presses)) return usage();
+    } else if (a == "--rx" && more) {
+      char* text;
+      unsigned long ms = strtoul(argv[++i], &text, 10);
+      if (*text != ':') return usage();
+      Operator::addLine(ms * 1000ULL, unescape(text + 1));
+    } else {
+      return usage();
+    }
+  }
+
+  FILE* sink = 0;
+  if (serialPath) {
+    sink = strcmp(serialPath, "-") ? fopen(serialPath, "wb") : stdout;
+    if (!sink) { perror(serialPath); return 1; }
+    Host::setSerialSink(sink);
+  }
+  if (eepromPath) Host::loadEeprom(eepromPath);
+  Operator::setPresses(presses);
+  Operator::install();
+
+  Operator::apply();
+  auto t0 = std::chrono::steady_clock::now();
+  setup();
+
+  Mode          last = ReactorStateMachine::getMode();
+  unsigned long loops = 0;
+  uint32_t      worstTickUs[MODE_COUNT] = {};
+  uint32_t      lastHash = 0;
+  unsigned long i2cBytes[MODE_COUNT] = {};
+  uint64_t      nextSample = 0;
+
+  while (Host::wallUs() < untilMs * 1000ULL) {
+    Operator::apply();
+    uint64_t start = Host::nowUs();
+    unsigned long i2c = Wire.transactions, bytes = Wire.bytes;
+    loop();
+    ++loops;
+    uint32_t took = (uint32_t)(Host::nowUs() - start);
+    Mode m = ReactorStateMachine::getMode();
+    if (took > worstTickUs[m]) worstTickUs[m] = took;
+    i2cBytes[m] += Wire.bytes - bytes;
+    if (m != last) {
+      fprintf(stderr, "%9.3f  %s -> %s\n", Host::wallUs() / 1000.0,
+              (const char*)ReactorStateMachine::modeName(last),
+              (const char*)ReactorStateMachine::modeName(m));
+      last = m;
+    }
+    // Full flushes and page flushes both end up on the bus
+    if (frames && Wire.transactions != i2c) {
+      uint32_t h = Host::frameHash(ReactorUI::display.getBuffer());
+      if (h != lastHash) fprintf(stderr, "%9.3f  frame %08x\n", Host::wallUs() / 1000.0, h);
+      lastHash = h;
+    }
+    if (sampleMs && Host::wallUs() >= nextSample) {
+      char pins[24];
+      for (uint8_t p = 0; p < 70; p += 3) {
+        pins[p / 3] = "0123456789abcdef"[Host::pinLevel(p) | Host::pinLevel(p + 1) << 1 | Host::pinLevel(p + 2) << 2];
+      }
+      pins[23] = 0;
+      fprintf(stderr, "%9llu  heat %3u frame %08x pins %s\n", (unsigned long long)(nextSample / 1000),
+              ReactorHeat::percent(), Host::frameHash(ReactorUI::display.getBuffer()), pins);
+      nextSample += sampleMs * 1000;
+    }
+    Host::advanceUs(stepUs);
+  }
+
+  double hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  if (sink && sink != stdout) fclose(sink);
+  if (eepromPath) Host::saveEeprom(eepromPath);
+  if (pbmPath) {
+    FILE* f = fopen(pbmPath, "wb");
+    if (f) { Host::writePbm(f, ReactorUI::display.getBuffer()); fclose(f); }
+  }
+
+  if (showTones) {
+    for (const Host::ToneEvent& t : Host::tones()) {
+      fprintf(stderr, "%9.3f  tone %u\n", t.atUs / 1000.0, t.hz);
+    }
+  }
+
+  fprintf(stderr, "# loop rates (ReactorDiag)\n");
+  ReactorDiag::printLoopRates(err);
+  fprintf(stderr, "# mode worst_pass_us i2c_bytes (virtual time, step excluded)\n");
+  for (uint8_t i = 0; i < MODE_COUNT; ++i) {
+    if (worstTickUs[i]) fprintf(stderr, "%s %u %lu\n", (const char*)ReactorStateMachine::modeName(i), worstTickUs[i], i2cBytes[i]);
+  }
+  fprintf(stderr, "loops %lu\n", loops);
+  fprintf(stderr, "virtual ms %llu (awake %llu)\n",
+          (unsigned long long)(Host::wallUs() / 1000), (unsigned long long)(Host::nowUs() / 1000));
+  fprintf(stderr, "host s %.3f (%.0fx real time)\n", hostSec, hostSec > 0 ? Host::wallUs() / 1e6 / hostSec : 0.0);
+  fprintf(stderr, "pin writes %lu\n", Host::pinWrites());
+  fprintf(stderr, "flushes %lu, i2c %lu transactions %lu bytes\n",
+          ReactorUI::display.flushes, Wire.transactions, Wire.bytes);
+  fprintf(stderr, "sleeps %lu\n", Host::sleeps());
+  fprintf(stderr, "frame %08x\n", Host::frameHash(ReactorUI::display.getBuffer()));
+  return 0;
+}
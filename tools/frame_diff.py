@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Compare framebuffer dumps (from the console 'frame' command) against golden PBMs.
+
+usage: frame_diff.py GOLDEN.pbm ACTUAL.pbm [DIFF.pbm]
+       frame_diff.py --split CAPTURE.log OUTDIR      # split a Serial log into PBM files
+
+Exit status is 1 when the frames differ. The report gives the mismatched pixel
+count, the bounding box of the differences, and the lit pixel count of each
+frame. DIFF.pbm, if given, marks the mismatched pixels.
+
+Host-rendered goldens (every renderer path) are in host/golden/ and are
+checked by 'make -C host golden'; its golden_out/ files open here too.
+"""
+import os
+import sys
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    tokens = []
+    pos = 0
+    # Header: magic, width, height (comments allowed)
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos) + 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos].decode())
+    magic, w, h = tokens[0], int(tokens[1]), int(tokens[2])
+    pos += 1
+    if magic == 'P1':
+        bits = [c - 48 for c in data[pos:] if c in (48, 49)]
+    elif magic == 'P4':
+        stride = (w + 7) // 8
+        bits = []
+        for y in range(h):
+            row = data[pos + y * stride:pos + (y + 1) * stride]
+            bits.extend((row[x // 8] >> (7 - x % 8)) & 1 for x in range(w))
+    else:
+        raise ValueError('%s: not a PBM (%s)' % (path, magic))
+    if len(bits) < w * h:
+        raise ValueError('%s: truncated raster' % path)
+    return w, h, bits[:w * h]
+
+
+def write_pbm(path, w, h, bits):
+    with open(path, 'w') as f:
+        f.write('P1\n%d %d\n' % (w, h))
+        for y in range(h):
+            f.write(''.join(str(b) for b in bits[y * w:(y + 1) * w]) + '\n')
+
+
+def split_log(log_path, out_dir):
+    os.makedirs(out_dir, exist_ok=True)
+    lines = open(log_path, errors='replace').read().splitlines()
+    n = 0
+    i = 0
+    while i < len(lines):
+        if lines[i].strip() == 'P1':
+            j = i + 1
+            while j < len(lines) and lines[j].startswith('#'):
+                j += 1
+            w, h = (int(v) for v in lines[j].split())
+            frame = lines[i:j + 1 + h]
+            path = os.path.join(out_dir, 'frame%04d.pbm' % n)
+            with open(path, 'w') as f:
+                f.write('\n'.join(frame) + '\n')
+            print(path)
+            n += 1
+            i = j + 1 + h
+        else:
+            i += 1
+
+
+def main(argv):
+    if len(argv) == 3 and argv[0] == '--split':
+        split_log(argv[1], argv[2])
+        return 0
+    if len(argv) not in (2, 3):
+        print(__doc__)
+        return 2
+    gw, gh, golden = read_pbm(argv[0])
+    aw, ah, actual = read_pbm(argv[1])
+    if (gw, gh) != (aw, ah):
+        print('size mismatch: golden %dx%d, actual %dx%d' % (gw, gh, aw, ah))
+        return 1
+    diff = [g ^ a for g, a in zip(golden, actual)]
+    bad = [i for i, d in enumerate(diff) if d]
+    print('lit: golden %d, actual %d' % (sum(golden), sum(actual)))
+    if not bad:
+        print('match')
+        return 0
+    xs = [i % gw for i in bad]
+    ys = [i // gw for i in bad]
+    print('%d pixels differ, bbox x=%d..%d y=%d..%d' % (len(bad), min(xs), max(xs), min(ys), max(ys)))
+    if len(argv) == 3:
+        write_pbm(argv[2], gw, gh, diff)
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
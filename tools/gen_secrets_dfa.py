@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Compile the secret button sequences into ReactorSecretsDfa.h.
+
+usage: gen_secrets_dfa.py [OUTPUT]      (default: ReactorSecretsDfa.h next to the sketch)
+
+Builds an Aho-Corasick automaton over the button alphabet and flattens it
+into a full DFA: one flash row per state, one byte per button. A press is a
+single table lookup, and every secret is found wherever it ends in the press
+stream. Add secrets to SECRETS below, rerun, and handle the new Secret value
+in ReactorSecrets::fire().
+"""
+import collections
+import os
+import sys
+
+# Button codes that feed the matcher (ACK is not part of any secret)
+ALPHABET = 'OSUFDE'
+
+# (enum name, pattern). Earlier entries win if two end on the same press.
+SECRETS = [
+    ('SECRET_GOD',   'OSFUO'),
+    ('SECRET_CHAOS', 'UUFSOF'),
+    ('SECRET_CRYO',  'FFOS'),
+]
+
+
+def build():
+    goto = [{}]
+    match = [0]
+    for idx, (_, pattern) in enumerate(SECRETS, start=1):
+        s = 0
+        for c in pattern:
+            if c not in ALPHABET:
+                raise ValueError('%r: %r is not a button code' % (pattern, c))
+            if c not in goto[s]:
+                goto.append({})
+                match.append(0)
+                goto[s][c] = len(goto) - 1
+            s = goto[s][c]
+        if not match[s]:
+            match[s] = idx
+
+    # Breadth-first failure links, folded straight into a complete DFA
+    fail = [0] * len(goto)
+    dfa = [[0] * len(ALPHABET) for _ in goto]
+    queue = collections.deque()
+    for i, c in enumerate(ALPHABET):
+        t = goto[0].get(c, 0)
+        dfa[0][i] = t
+        if t:
+            queue.append(t)
+    while queue:
+        s = queue.popleft()
+        if not match[s]:
+            match[s] = match[fail[s]]
+        for i, c in enumerate(ALPHABET):
+            t = goto[s].get(c)
+            if t is None:
+                dfa[s][i] = dfa[fail[s]][i]
+            else:
+                fail[t] = dfa[fail[s]][i]
+                dfa[s][i] = t
+                queue.append(t)
+    return dfa, match
+
+
+def render(dfa, match):
+    if len(dfa) > 255:
+        raise ValueError('too many states for a uint8_t table')
+    out = []
+    w = out.append
+    w('#pragma once')
+    w('')
+    w('// Generated by tools/gen_secrets_dfa.py -- do not edit; rerun the script.')
+    w('// Secret sequences: ' + ', '.join('%s "%s"' % (n, p) for n, p in SECRETS))
+    w('')
+    w('namespace ReactorSecretsDfa {')
+    w('')
+    w('enum Secret : uint8_t {')
+    w('  SECRET_NONE,')
+    for name, _ in SECRETS:
+        w('  %s,' % name)
+    w('};')
+    w('')
+    w('const uint8_t SYMBOL_COUNT = %d;   // %s' % (len(ALPHABET), ' '.join(ALPHABET)))
+    w('const uint8_t STATE_COUNT  = %d;' % len(dfa))
+    w('')
+    w('// Alphabet index of a button code, or SYMBOL_COUNT if it is not in any secret')
+    w('inline uint8_t symbolOf(char code) {')
+    w('  switch (code) {')
+    for i, c in enumerate(ALPHABET):
+        w("    case '%s': return %d;" % (c, i))
+    w('    default:  return SYMBOL_COUNT;')
+    w('  }')
+    w('}')
+    w('')
+    w('const uint8_t NEXT[STATE_COUNT][SYMBOL_COUNT] PROGMEM = {')
+    for s, row in enumerate(dfa):
+        w('  { %s },  // %d' % (', '.join('%2d' % t for t in row), s))
+    w('};')
+    w('')
+    w('// Secret completed on entering each state')
+    w('const uint8_t MATCH[STATE_COUNT] PROGMEM = {')
+    w('  ' + ', '.join(str(m) for m in match))
+    w('};')
+    w('')
+    w('} // namespace ReactorSecretsDfa')
+    return '\n'.join(out) + '\n'
+
+
+def main(argv):
+    here = os.path.dirname(os.path.abspath(__file__))
+    path = argv[0] if argv else os.path.join(here, '..', 'ReactorSecretsDfa.h')
+    dfa, match = build()
+    with open(path, 'w') as f:
+        f.write(render(dfa, match))
+    print('%s: %d states, %d bytes of flash' % (os.path.normpath(path), len(dfa),
+                                                 len(dfa) * (len(ALPHABET) + 1)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Rebuild the OLED image from the framebuffer mirror stream (ReactorMirror).
+
+usage: mirror_view.py CAPTURE.bin OUTDIR            # one PBM per pass
+       mirror_view.py CAPTURE.bin OUT.gif           # animated GIF
+       mirror_view.py /dev/ttyACM0 OUTDIR [--baud 115200]
+
+Build with -DREACTOR_MIRROR, then turn the mirror on with 'tune mirror_ms 200'
+('mirror' on the console forces a full resend). Passes that end before the
+first keyframe are skipped, since the image is only known after a 'K'
+packet. PBM files are binary (P4) and open in frame_diff.py. GIF frames are
+timed from the host clock for a device, or at a fixed --fps for a capture
+file.
+"""
+import argparse
+import os
+import sys
+import time
+
+from telemetry_decode import open_input, packets
+
+WIDTH, HEIGHT = 128, 64
+PAGES = HEIGHT // 8
+
+
+class Mirror:
+    def __init__(self):
+        self.fb = bytearray(WIDTH * PAGES)
+        self.synced = False
+
+    def apply(self, raw):
+        """Feed one packet; returns True when a pass completed."""
+        kind = chr(raw[0])
+        if kind == 'K':
+            self.fb = bytearray(WIDTH * PAGES)
+            self.synced = True
+        elif kind == 'P' and len(raw) >= 4:
+            page, col, data = raw[2], raw[3], raw[4:]
+            pos = page * WIDTH + col
+            end = (page + 1) * WIDTH
+            i = 0
+            while i < len(data):
+                n = data[i]
+                if n >= 0x80:
+                    run = [data[i + 1]] * (n - 0x7F) if i + 1 < len(data) else []
+                    i += 2
+                else:
+                    run = data[i + 1:i + 2 + n]
+                    i += 2 + n
+                for d in run:
+                    if pos < end:
+                        self.fb[pos] ^= d
+                    pos += 1
+        elif kind == 'E':
+            return self.synced
+        return False
+
+    def rows(self):
+        """Pixel rows, 1 = lit."""
+        for y in range(HEIGHT):
+            base, bit = (y // 8) * WIDTH, 1 << (y & 7)
+            yield [1 if self.fb[base + x] & bit else 0 for x in range(WIDTH)]
+
+
+def pbm(rows):
+    out = bytearray(b'P4\n%d %d\n' % (WIDTH, HEIGHT))
+    for row in rows:
+        for x in range(0, WIDTH, 8):
+            byte = 0
+            for b in row[x:x + 8]:
+                byte = (byte << 1) | b
+            out.append(byte)
+    return bytes(out)
+
+
+def lzw(pixels, min_size=2):
+    """GIF LZW: pack pixel indices into sub-blocks."""
+    clear, stop = 1 << min_size, (1 << min_size) + 1
+    table = {(i,): i for i in range(clear)}
+    size, nxt = min_size + 1, stop + 1
+    acc = bits = 0
+    out = bytearray()
+
+    def emit(code):
+        nonlocal acc, bits
+        acc |= code << bits
+        bits += size
+        while bits >= 8:
+            out.append(acc & 0xFF)
+            acc >>= 8
+            bits -= 8
+
+    emit(clear)
+    cur = ()
+    for p in pixels:
+        key = cur + (p,)
+        if key in table:
+            cur = key
+            continue
+        emit(table[cur])
+        if nxt < 4096:
+            table[key] = nxt
+            nxt += 1
+            if nxt > (1 << size) and size < 12:
+                size += 1
+        else:
+            emit(clear)
+            table = {(i,): i for i in range(clear)}
+            size, nxt = min_size + 1, stop + 1
+        cur = (p,)
+    emit(table[cur])
+    emit(stop)
+    if bits:
+        out.append(acc & 0xFF)
+    blocks = bytearray([min_size])
+    for i in range(0, len(out), 255):
+        part = out[i:i + 255]
+        blocks += bytes([len(part)]) + part
+    return bytes(blocks + b'\0')
+
+
+def write_gif(path, frames):
+    """frames: [(rows, delay_cs)]"""
+    le = lambda v: bytes([v & 0xFF, v >> 8])
+    with open(path, 'wb') as f:
+        f.write(b'GIF89a' + le(WIDTH) + le(HEIGHT) + bytes([0x80, 0, 0]))
+        f.write(b'\0\0\0' + b'\xff\xff\xff')             # 2-colour palette
+        f.write(b'\x21\xff\x0bNETSCAPE2.0\x03\x01\0\0\0')  # loop forever
+        for rows, delay in frames:
+            f.write(b'\x21\xf9\x04\0' + le(delay) + b'\0\0')
+            f.write(b'\x2c\0\0\0\0' + le(WIDTH) + le(HEIGHT) + b'\0')
+            f.write(lzw([p for row in rows for p in row]))
+        f.write(b'\x3b')
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('input')
+    ap.add_argument('output', help='directory for PBM frames, or a .gif path')
+    ap.add_argument('--baud', type=int, default=115200)
+    ap.add_argument('--fps', type=float, default=5.0,
+                    help='GIF frame rate for capture files (default 5)')
+    args = ap.parse_args(argv)
+
+    gif = args.output.lower().endswith('.gif')
+    if not gif:
+        os.makedirs(args.output, exist_ok=True)
+    live = args.input.startswith('/dev/')
+    mirror = Mirror()
+    frames = []
+    last = time.time()
+    n = 0
+    with open_input(args.input, args.baud) as stream:
+        try:
+            for raw in packets(stream):
+                if not mirror.apply(raw):
+                    continue
+                rows = list(mirror.rows())
+                n += 1
+                if gif:
+                    now = time.time()
+                    delay = int((now - last) * 100) if live else int(100 / args.fps)
+                    last = now
+                    if frames and rows == frames[-1][0]:
+                        frames[-1] = (rows, frames[-1][1] + max(delay, 1))
+                    else:
+                        frames.append((rows, max(delay, 1)))
+                else:
+                    path = os.path.join(args.output, 'frame_%05d.pbm' % n)
+                    with open(path, 'wb') as f:
+                        f.write(pbm(rows))
+        except KeyboardInterrupt:
+            pass
+    if gif and frames:
+        write_gif(args.output, frames)
+    print('%d frames, %d packets rejected' % (n, packets.bad), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Per-module static SRAM breakdown of a built sketch.
+
+usage: ram_report.py SKETCH.elf [--nm avr-nm] [-v]
+
+Run it on the .elf the Arduino build leaves behind (arduino-cli compile
+--output-dir, or the IDE's temporary build folder). It adds up the .data and
+.bss symbols by their top-level namespace, so ReactorUI::display and
+ReactorDiag::(anonymous namespace)::hist are charged to ReactorUI and
+ReactorDiag. Symbols outside a namespace (core, libraries, string literals
+copied to RAM) are grouped under '(other)'. Use -v to list the symbols.
+"""
+import argparse
+import collections
+import subprocess
+import sys
+
+RAM_TYPES = set('bBdD')
+MEGA_SRAM = 8192
+
+
+def module_of(name):
+    if '::' in name:
+        head = name.split('::', 1)[0]
+        if head and not head.startswith('('):
+            return head
+    return '(other)'
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('elf')
+    ap.add_argument('--nm', default='avr-nm')
+    ap.add_argument('-v', action='store_true', help='list symbols per module')
+    args = ap.parse_args()
+
+    out = subprocess.run([args.nm, '-C', '-S', '--size-sort', args.elf],
+                         check=True, capture_output=True, text=True).stdout
+    modules = collections.defaultdict(list)
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) != 4 or parts[2] not in RAM_TYPES:
+            continue
+        size = int(parts[1], 16)
+        modules[module_of(parts[3])].append((size, parts[2], parts[3]))
+
+    total = sum(s for syms in modules.values() for s, _, _ in syms)
+    rows = sorted(modules.items(), key=lambda kv: -sum(s for s, _, _ in kv[1]))
+    print('%-24s %6s %6s %6s' % ('module', 'data', 'bss', 'total'))
+    for name, syms in rows:
+        data = sum(s for s, t, _ in syms if t in 'dD')
+        bss = sum(s for s, t, _ in syms if t in 'bB')
+        print('%-24s %6d %6d %6d' % (name, data, bss, data + bss))
+        if args.v:
+            for size, _, sym in sorted(syms, reverse=True):
+                print('    %6d  %s' % (size, sym))
+    print('%-24s %6s %6s %6d  (%d%% of %d; heap and stack get the rest)'
+          % ('total', '', '', total, total * 100 // MEGA_SRAM, MEGA_SRAM))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
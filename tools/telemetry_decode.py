@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry stream (ReactorTelemetry) into CSV.
+
+usage: telemetry_decode.py CAPTURE.bin [OUT.csv]
+       telemetry_decode.py /dev/ttyACM0 [OUT.csv] [--baud 115200]
+
+Turn the stream on first with the console command 'tune telemetry_ms 100'.
+Input is a raw Serial capture, or a serial device (needs pyserial). Frames
+are COBS-encoded between 0x00 delimiters. Console text and corrupted frames
+fail the CRC and are skipped; the count goes to stderr. Output has one CSV
+row per frame and goes to stdout when OUT.csv is not given.
+"""
+import argparse
+import csv
+import struct
+import sys
+
+PAYLOAD = struct.Struct('<BBIBHBBBBHHIHH')
+FIELDS = ['seq', 'millis', 'mode', 'heat_q8', 'step', 'incidents', 'button',
+          'muted', 'god', 'runaway', 'loops', 'loop_mean_us', 'loop_max_us',
+          'frame_max_us', 'dropped']
+MODES = ['STABLE', 'ARMING', 'CRITICAL', 'MELTDOWN', 'STABILIZING', 'STARTUP',
+         'FREEZEDOWN', 'SHUTDOWN', 'DARK', 'CHAOS']
+
+
+def crc_ccitt(data):
+    """avr-libc _crc_ccitt_update, init 0xFFFF."""
+    crc = 0xFFFF
+    for b in data:
+        b ^= crc & 0xFF
+        b = (b ^ (b << 4)) & 0xFF
+        crc = (((b << 8) | (crc >> 8)) ^ (b >> 4) ^ (b << 3)) & 0xFFFF
+    return crc
+
+
+def cobs_decode(chunk):
+    out = bytearray()
+    i = 0
+    while i < len(chunk):
+        code = chunk[i]
+        if code == 0 or i + code > len(chunk):
+            return None
+        out += chunk[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(chunk):
+            out.append(0)
+    return bytes(out)
+
+
+def packets(stream):
+    """Yield CRC-checked payloads of every framed packet (telemetry, mirror);
+    counts rejects in packets.bad."""
+    buf = bytearray()
+    while True:
+        data = stream.read(256)
+        if not data:
+            break
+        buf += data
+        while True:
+            end = buf.find(b'\0')
+            if end < 0:
+                break
+            chunk, buf = bytes(buf[:end]), buf[end + 1:]
+            if not chunk:
+                continue
+            raw = cobs_decode(chunk)
+            if (raw is None or len(raw) < 3
+                    or crc_ccitt(raw[:-2]) != struct.unpack('<H', raw[-2:])[0]):
+                packets.bad += 1
+                continue
+            yield raw[:-2]
+
+
+packets.bad = 0
+
+
+def frames(stream):
+    """Yield unpacked status frames; other packet types are ignored."""
+    for raw in packets(stream):
+        if raw[0] == ord('T'):
+            if len(raw) != PAYLOAD.size:
+                packets.bad += 1
+                continue
+            yield PAYLOAD.unpack(raw)
+
+
+def row(fields):
+    (_, seq, millis, mode, heat, step, incidents, button, flags,
+     loops, loop_mean, loop_max, frame_max, dropped) = fields
+    return [seq, millis, MODES[mode] if mode < len(MODES) else mode, heat, step,
+            incidents, chr(button) if button else '', flags & 1, (flags >> 1) & 1,
+            (flags >> 2) & 1, loops, loop_mean, loop_max, frame_max, dropped]
+
+
+def open_input(path, baud):
+    if path.startswith('/dev/'):
+        import serial  # pyserial
+        return serial.Serial(path, baud, timeout=1)
+    return open(path, 'rb')
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('input')
+    ap.add_argument('output', nargs='?')
+    ap.add_argument('--baud', type=int, default=115200)
+    args = ap.parse_args(argv)
+
+    out = open(args.output, 'w', newline='') if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(FIELDS)
+    n = 0
+    with open_input(args.input, args.baud) as stream:
+        try:
+            for fields in frames(stream):
+                writer.writerow(row(fields))
+                n += 1
+        except KeyboardInterrupt:
+            pass
+    print('%d frames, %d rejected' % (n, packets.bad), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))